@@ -24,19 +24,102 @@ THE SOFTWARE.
 
 #include <Artnet.h>
 
-Artnet::Artnet() {}
+Artnet::Artnet()
+    : numPollReplies(0), outputFirst(0), outputCount(0), packetBuffer(artnetPacket),
+      readSize(0), filtered(false), firstUniverse(0), numUniverses(0)
+{
+  memset(node_mac, 0, sizeof(node_mac));
+  memset(nodeShortName, 0, sizeof(nodeShortName));
+  memset(nodeLongName, 0, sizeof(nodeLongName));
+  strncpy(nodeShortName, "artnet arduino", sizeof(nodeShortName) - 1);
+  strncpy(nodeLongName, "Art-Net -> Arduino Bridge", sizeof(nodeLongName) - 1);
+}
 
 void Artnet::begin(byte mac[], byte ip[])
 {
+  memcpy(node_mac, mac, sizeof(node_mac));
 #if !defined(ARDUINO_SAMD_ZERO) && !defined(ESP8266) && !defined(ESP32)
   Ethernet.begin(mac, ip);
 #endif
   Udp.begin(ART_NET_PORT);
+  buildPollReplies();
 }
 
 void Artnet::begin()
 {
   Udp.begin(ART_NET_PORT);
+  buildPollReplies();
+}
+
+void Artnet::setNodeName(const char *shortName, const char *longName)
+{
+  strncpy(nodeShortName, shortName, sizeof(nodeShortName) - 1);
+  strncpy(nodeLongName, longName, sizeof(nodeLongName) - 1);
+  buildPollReplies();
+}
+
+void Artnet::setOutputUniverses(uint16_t first, uint16_t count)
+{
+  outputFirst = first;
+  outputCount = count;
+  buildPollReplies();
+}
+
+void Artnet::buildPollReplies()
+{
+#if !defined(ARDUINO_SAMD_ZERO) && !defined(ESP8266) && !defined(ESP32)
+  IPAddress local_ip = Ethernet.localIP();
+#else
+  IPAddress local_ip = WiFi.localIP();
+#endif
+  for (uint8_t i = 0; i < 4; i++)
+    node_ip_address[i] = local_ip[i];
+
+  // fields shared by every page
+  struct artnet_reply_s reply;
+  memset(&reply, 0, sizeof(reply));
+  memcpy(reply.id, ART_NET_ID, sizeof(reply.id));
+  reply.opCode = ART_POLL_REPLY;
+  memcpy(reply.ip, node_ip_address, sizeof(reply.ip));
+  reply.port = ART_NET_PORT;
+  reply.verH = 1;
+  reply.ver = 0;
+  reply.oemH = 0;
+  reply.oem = 0xFF;
+  reply.status = 0xd2;
+  memcpy(reply.shortname, nodeShortName, sizeof(reply.shortname));
+  memcpy(reply.longname, nodeLongName, sizeof(reply.longname));
+  reply.style = 0; // StNode
+  memcpy(reply.mac, node_mac, sizeof(reply.mac));
+  memcpy(reply.bindip, node_ip_address, sizeof(reply.bindip));
+  reply.status2 = 0x08; // 15 bit Port-Address
+
+  // Art-Net 4: up to 4 output ports per page, in one Net and Sub-Net, the
+  // pages told apart by their bind index (1 for the first)
+  numPollReplies = 0;
+  uint32_t universe = outputFirst;
+  uint32_t end = outputFirst + outputCount;
+  do
+  {
+    struct artnet_reply_s &page = pollReplies[numPollReplies];
+    page = reply;
+    page.subH = (universe >> 8) & 0x7F; // Net
+    page.sub = (universe >> 4) & 0x0F;  // Sub-Net
+    uint32_t base = universe & 0x7FF0;
+    uint8_t ports = 0;
+    while (ports < 4 && universe < end && (universe & 0x7FF0) == base)
+    {
+      page.porttypes[ports] = 0x80;  // DMX512 output from Art-Net
+      page.goodinput[ports] = 0x08;  // input disabled
+      page.goodoutput[ports] = 0x80; // data transmitted
+      page.swout[ports] = universe & 0x0F;
+      ports++;
+      universe++;
+    }
+    page.numbports = ports;
+    page.bindindex = ++numPollReplies;
+    snprintf((char *)page.nodereport, sizeof(page.nodereport), "#0001 [0000] %u output universes", outputCount);
+  } while (universe < end && numPollReplies < ARTNET_MAX_POLL_REPLIES);
 }
 
 void Artnet::setBroadcast(byte bc[])
@@ -45,106 +128,87 @@ void Artnet::setBroadcast(byte bc[])
   broadcast = bc;
 }
 
+void Artnet::setUniverseFilter(uint16_t first, uint16_t count)
+{
+  firstUniverse = first;
+  numUniverses = count;
+}
+
 uint16_t Artnet::read()
 {
   packetSize = Udp.parsePacket();
+  readSize = 0;
+  filtered = false;
 
   remoteIP = Udp.remoteIP();
   if (packetSize <= MAX_BUFFER_ARTNET && packetSize > 0)
   {
-    Udp.read(artnetPacket, MAX_BUFFER_ARTNET);
+    // Header first: ArtDmx of other universes are dropped without copying
+    // their data, the rest of the datagram goes with the next parsePacket()
+    readSize = Udp.read(packetBuffer, packetSize < ART_DMX_START ? packetSize : ART_DMX_START);
+    if (readSize < 10)
+      return 0;
 
     // Check that packetID is "Art-Net" else ignore
     for (byte i = 0; i < 8; i++)
     {
-      if (artnetPacket[i] != ART_NET_ID[i])
+      if (packetBuffer[i] != ART_NET_ID[i])
         return 0;
     }
 
-    opcode = artnetPacket[8] | artnetPacket[9] << 8;
+    opcode = packetBuffer[8] | packetBuffer[9] << 8;
 
     if (opcode == ART_DMX)
     {
-      sequence = artnetPacket[12];
-      incomingUniverse = artnetPacket[14] | artnetPacket[15] << 8;
-      dmxDataLength = artnetPacket[17] | artnetPacket[16] << 8;
+      if (readSize < ART_DMX_START)
+        return 0;
+      sequence = packetBuffer[12];
+      incomingUniverse = packetBuffer[14] | packetBuffer[15] << 8;
+      dmxDataLength = packetBuffer[17] | packetBuffer[16] << 8;
+      if (numUniverses && (uint16_t)(incomingUniverse - firstUniverse) >= numUniverses)
+      {
+        filtered = true;
+        return 0;
+      }
+      readSize += Udp.read(packetBuffer + ART_DMX_START, packetSize - ART_DMX_START);
+      // the header length is not trusted past the bytes actually received
+      if (dmxDataLength > readSize - ART_DMX_START)
+        dmxDataLength = readSize - ART_DMX_START;
 
       if (artDmxCallback)
-        (*artDmxCallback)(incomingUniverse, dmxDataLength, sequence, artnetPacket + ART_DMX_START, remoteIP);
+        (*artDmxCallback)(incomingUniverse, dmxDataLength, sequence, packetBuffer + ART_DMX_START, remoteIP);
       return ART_DMX;
     }
-    if (opcode == ART_POLL)
+    if (opcode == ART_PIXEL)
     {
-      // fill the reply struct, and then send it to the network's broadcast address
-      Serial.print("POLL from ");
-      Serial.print(remoteIP);
-      Serial.print(" broadcast addr: ");
-      Serial.println(broadcast);
+      if (readSize < ART_DMX_START)
+        return 0;
+      sequence = packetBuffer[10];
+      incomingFrame = packetBuffer[12] | packetBuffer[13] << 8;
+      firstPixel = packetBuffer[14] | packetBuffer[15] << 8;
+      dmxDataLength = packetBuffer[17] | packetBuffer[16] << 8;
+      readSize += Udp.read(packetBuffer + ART_DMX_START, packetSize - ART_DMX_START);
+      if (dmxDataLength > readSize - ART_DMX_START)
+        dmxDataLength = readSize - ART_DMX_START;
 
-#if !defined(ARDUINO_SAMD_ZERO) && !defined(ESP8266) && !defined(ESP32)
-      IPAddress local_ip = Ethernet.localIP();
-#else
-      IPAddress local_ip = WiFi.localIP();
-#endif
-      node_ip_address[0] = local_ip[0];
-      node_ip_address[1] = local_ip[1];
-      node_ip_address[2] = local_ip[2];
-      node_ip_address[3] = local_ip[3];
-
-      sprintf((char *)id, "Art-Net");
-      memcpy(ArtPollReply.id, id, sizeof(ArtPollReply.id));
-      memcpy(ArtPollReply.ip, node_ip_address, sizeof(ArtPollReply.ip));
-
-      ArtPollReply.opCode = ART_POLL_REPLY;
-      ArtPollReply.port = ART_NET_PORT;
-
-      memset(ArtPollReply.goodinput, 0x08, 4);
-      memset(ArtPollReply.goodoutput, 0x80, 4);
-      memset(ArtPollReply.porttypes, 0xc0, 4);
-
-      uint8_t shortname[18];
-      uint8_t longname[64];
-      sprintf((char *)shortname, "artnet arduino");
-      sprintf((char *)longname, "Art-Net -> Arduino Bridge");
-      memcpy(ArtPollReply.shortname, shortname, sizeof(shortname));
-      memcpy(ArtPollReply.longname, longname, sizeof(longname));
-
-      ArtPollReply.etsaman[0] = 0;
-      ArtPollReply.etsaman[1] = 0;
-      ArtPollReply.verH = 1;
-      ArtPollReply.ver = 0;
-      ArtPollReply.subH = 0;
-      ArtPollReply.sub = 0;
-      ArtPollReply.oemH = 0;
-      ArtPollReply.oem = 0xFF;
-      ArtPollReply.ubea = 0;
-      ArtPollReply.status = 0xd2;
-      ArtPollReply.swvideo = 0;
-      ArtPollReply.swmacro = 0;
-      ArtPollReply.swremote = 0;
-      ArtPollReply.style = 0;
-
-      ArtPollReply.numbportsH = 0;
-      ArtPollReply.numbports = 4;
-      ArtPollReply.status2 = 0x08;
-
-      ArtPollReply.bindip[0] = node_ip_address[0];
-      ArtPollReply.bindip[1] = node_ip_address[1];
-      ArtPollReply.bindip[2] = node_ip_address[2];
-      ArtPollReply.bindip[3] = node_ip_address[3];
-
-      uint8_t swin[4] = {0x01, 0x02, 0x03, 0x04};
-      uint8_t swout[4] = {0x01, 0x02, 0x03, 0x04};
-      for (uint8_t i = 0; i < 4; i++)
+      if (artPixelCallback)
+        (*artPixelCallback)(incomingFrame, firstPixel, dmxDataLength, sequence, packetBuffer[11], packetBuffer + ART_DMX_START, remoteIP);
+      return ART_PIXEL;
+    }
+    if (packetSize > readSize)
+      readSize += Udp.read(packetBuffer + readSize, packetSize - readSize);
+
+    if (opcode == ART_POLL)
+    {
+      // one reply per page, built in advance by buildPollReplies(). Sent to
+      // the controller unless a broadcast address was set.
+      IPAddress to = (uint32_t)broadcast ? broadcast : remoteIP;
+      for (uint8_t i = 0; i < numPollReplies; i++)
       {
-        ArtPollReply.swout[i] = swout[i];
-        ArtPollReply.swin[i] = swin[i];
+        Udp.beginPacket(to, ART_NET_PORT);
+        Udp.write((uint8_t *)&pollReplies[i], sizeof(pollReplies[i]));
+        Udp.endPacket();
       }
-      sprintf((char *)ArtPollReply.nodereport, "%i DMX output universes active.", ArtPollReply.numbports);
-      Udp.beginPacket(broadcast, ART_NET_PORT); // send the packet to the broadcast address
-      Udp.write((uint8_t *)&ArtPollReply, sizeof(ArtPollReply));
-      Udp.endPacket();
-
       return ART_POLL;
     }
     if (opcode == ART_SYNC)
@@ -161,6 +225,31 @@ uint16_t Artnet::read()
   return 0;
 }
 
+artnet_read_stats_s Artnet::readAll(uint16_t maxPackets, uint32_t budgetMicros)
+{
+  artnet_read_stats_s stats = {0, 0, 0, 0};
+  uint32_t start = micros();
+
+  while (stats.packets + stats.rejects < maxPackets)
+  {
+    uint16_t result = read();
+    if (packetSize == 0)
+      break; // socket drained
+
+    stats.bytes += readSize;
+    if (filtered)
+      stats.filtered++;
+    else if (result == 0 && (readSize < 10 || memcmp(packetBuffer, ART_NET_ID, 8) != 0))
+      stats.rejects++;
+    else
+      stats.packets++;
+
+    if (micros() - start >= budgetMicros)
+      break;
+  }
+  return stats;
+}
+
 void Artnet::printPacketHeader()
 {
   Serial.print("packet size = ");
@@ -179,7 +268,7 @@ void Artnet::printPacketContent()
 {
   for (uint16_t i = ART_DMX_START; i < dmxDataLength; i++)
   {
-    Serial.print(artnetPacket[i], DEC);
+    Serial.print(packetBuffer[i], DEC);
     Serial.print("  ");
   }
   Serial.println('\n');
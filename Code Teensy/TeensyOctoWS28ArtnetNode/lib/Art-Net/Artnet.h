@@ -36,7 +36,7 @@ THE SOFTWARE.
 #elif defined(ESP32)
   #include <WiFi.h>
   #include <WiFiUdp.h>
-#elif defined(__IMXRT1062__)
+#elif defined(__IMXRT1062__) || defined(NATIVE_HOST)
   #include <NativeEthernet.h>
   #include <NativeEthernetUdp.h>
 #else
@@ -52,11 +52,38 @@ THE SOFTWARE.
 #define ART_POLL_REPLY 0x2100
 #define ART_DMX 0x5000
 #define ART_SYNC 0x5200
-// Buffers
-#define MAX_BUFFER_ARTNET 530
+// Not an Art-Net opcode: pixel packet of a whole frame split by pixel offset,
+// sent by video2artnet.py. Art-Net nodes ignore it as an unknown opcode.
+//  0-7 "Art-Net", 8-9 opcode, 10 sequence, 11 flags, 12-13 frame (LSB first),
+//  14-15 first pixel (LSB first), 16-17 length (MSB first), 18 RGB data
+#define ART_PIXEL 0x5F00
+// Flag of the last packet of a frame
+#define ART_PIXEL_LAST 0x01
+// Run-length coded data, see src/PixelDecoder.h
+#define ART_PIXEL_RLE 0x02
+// Coded against the previous frame (unchanged pixels are skipped)
+#define ART_PIXEL_DELTA 0x04
+// RGB bytes of a pixel packet: 484 pixels, 1472 bytes with the header, the
+// UDP payload of a 1500 byte Ethernet MTU
+#define ART_PIXEL_MAX_LENGTH 1452
+// Receive ART_PIXEL packets, 0 to keep 530 byte buffers
+#ifndef ARTNET_PIXEL_PACKETS
+#define ARTNET_PIXEL_PACKETS 1
+#endif
 // Packet
 #define ART_NET_ID "Art-Net\0"
 #define ART_DMX_START 18
+// Buffers
+#if ARTNET_PIXEL_PACKETS
+#define MAX_BUFFER_ARTNET (ART_DMX_START + ART_PIXEL_MAX_LENGTH)
+#else
+#define MAX_BUFFER_ARTNET 530
+#endif
+// Largest number of ArtPollReply pages (4 output universes each, a page
+// does not cross a Sub-Net)
+#ifndef ARTNET_MAX_POLL_REPLIES
+#define ARTNET_MAX_POLL_REPLIES 12
+#endif
 
 struct artnet_reply_s
 {
@@ -97,6 +124,15 @@ struct artnet_reply_s
   uint8_t filler[26];
 } __attribute__((packed));
 
+// Counters returned by Artnet::readAll()
+struct artnet_read_stats_s
+{
+  uint16_t packets;  // Art-Net packets handled
+  uint32_t bytes;    // UDP payload bytes copied out of the socket
+  uint16_t rejects;  // oversized or non Art-Net packets
+  uint16_t filtered; // ArtDmx of other universes, only the header was read
+};
+
 class Artnet
 {
 public:
@@ -105,14 +141,30 @@ public:
   void begin(byte mac[], byte ip[]);
   void begin();
   void setBroadcast(byte bc[]);
+  // Name of the node in the ArtPollReply (17 and 63 characters at most)
+  void setNodeName(const char *shortName, const char *longName);
+  // Output universes advertised in the ArtPollReply pages
+  void setOutputUniverses(uint16_t first, uint16_t count);
+  // Only hand ArtDmx of count universes from first to the callback, the
+  // others are dropped after their 18 byte header. count 0 for all.
+  void setUniverseFilter(uint16_t first, uint16_t count);
   uint16_t read();
+  // Read every pending packet, up to maxPackets or until budgetMicros elapsed
+  artnet_read_stats_s readAll(uint16_t maxPackets, uint32_t budgetMicros);
   void printPacketHeader();
   void printPacketContent();
 
   // Return a pointer to the start of the DMX data
   inline uint8_t *getDmxFrame(void)
   {
-    return artnetPacket + ART_DMX_START;
+    return packetBuffer + ART_DMX_START;
+  }
+
+  // Receive the next packets into buffer (at least MAX_BUFFER_ARTNET bytes)
+  // instead of the internal one, nullptr to go back to the internal buffer
+  inline void setPacketBuffer(uint8_t *buffer)
+  {
+    packetBuffer = buffer ? buffer : artnetPacket;
   }
 
   inline uint16_t getOpcode(void)
@@ -135,6 +187,16 @@ public:
     return dmxDataLength;
   }
 
+  inline uint16_t getFrame(void)
+  {
+    return incomingFrame;
+  }
+
+  inline uint16_t getFirstPixel(void)
+  {
+    return firstPixel;
+  }
+
   inline IPAddress getRemoteIP(void)
   {
     return remoteIP;
@@ -150,26 +212,47 @@ public:
     artSyncCallback = fptr;
   }
 
+  inline void setArtPixelCallback(void (*fptr)(uint16_t frame, uint16_t firstPixel, uint16_t length, uint8_t sequence, uint8_t flags, uint8_t *data, IPAddress remoteIP))
+  {
+    artPixelCallback = fptr;
+  }
+
 private:
   uint8_t node_ip_address[4];
-  uint8_t id[8];
+  uint8_t node_mac[6];
+  char nodeShortName[18];
+  char nodeLongName[64];
 #if defined(ARDUINO_SAMD_ZERO) || defined(ESP8266) || defined(ESP32)
   WiFiUDP Udp;
 #else
   EthernetUDP Udp;
 #endif
-  struct artnet_reply_s ArtPollReply;
+  // Built by begin() and each setting, sent as is on ART_POLL
+  struct artnet_reply_s pollReplies[ARTNET_MAX_POLL_REPLIES];
+  uint8_t numPollReplies;
+  uint16_t outputFirst;
+  uint16_t outputCount;
 
   uint8_t artnetPacket[MAX_BUFFER_ARTNET];
+  uint8_t *packetBuffer;
   uint16_t packetSize;
+  uint16_t readSize; // bytes of the last packet copied to packetBuffer
+  bool filtered;     // last packet was an ArtDmx of another universe
+  uint16_t firstUniverse;
+  uint16_t numUniverses;
   IPAddress broadcast;
   uint16_t opcode;
   uint8_t sequence;
   uint16_t incomingUniverse;
   uint16_t dmxDataLength;
+  uint16_t incomingFrame;
+  uint16_t firstPixel;
   IPAddress remoteIP;
   void (*artDmxCallback)(uint16_t universe, uint16_t length, uint8_t sequence, uint8_t *data, IPAddress remoteIP);
   void (*artSyncCallback)(IPAddress remoteIP);
+  void (*artPixelCallback)(uint16_t frame, uint16_t firstPixel, uint16_t length, uint8_t sequence, uint8_t flags, uint8_t *data, IPAddress remoteIP);
+
+  void buildPollReplies();
 };
 
 #endif
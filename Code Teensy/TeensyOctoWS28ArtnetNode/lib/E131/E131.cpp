@@ -0,0 +1,149 @@
+/* E1.31 (sACN) receiver for the Teensy OctoWS28 Artnet Node, see E131.h */
+
+#include <E131.h>
+
+// ACN packet identifier of the root layer
+static const uint8_t ACN_ID[12] = {'A', 'S', 'C', '-', 'E', '1', '.', '1', '7', 0, 0, 0};
+// Vectors of the root, framing and DMP layers
+#define VECTOR_ROOT_E131_DATA 0x00000004
+#define VECTOR_ROOT_E131_EXTENDED 0x00000008
+#define VECTOR_E131_DATA_PACKET 0x00000002
+#define VECTOR_E131_EXTENDED_SYNCHRONIZATION 0x00000001
+#define VECTOR_DMP_SET_PROPERTY 0x02
+
+static inline uint16_t be16(const uint8_t *p)
+{
+  return p[0] << 8 | p[1];
+}
+
+static inline uint32_t be32(const uint8_t *p)
+{
+  return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | p[2] << 8 | p[3];
+}
+
+E131::E131()
+    : numSockets(0), nextSocket(0), firstUniverse(0), dataBuffer(dmxData),
+      packetSize(0), readSize(0), valid(false), filtered(false), incomingUniverse(0), dmxDataLength(0), sequence(0),
+      priority(0), dataCallback(nullptr), syncCallback(nullptr) {}
+
+uint16_t E131::begin(uint16_t firstUniverse, uint16_t count)
+{
+  for (uint16_t i = 0; i < numSockets; i++)
+    Udp[i].stop();
+  numSockets = 0;
+  nextSocket = 0;
+  this->firstUniverse = firstUniverse;
+
+  if (count > E131_MAX_UNIVERSES)
+    count = E131_MAX_UNIVERSES;
+  for (uint16_t i = 0; i < count; i++)
+  {
+    uint16_t universe = firstUniverse + i;
+    IPAddress group(239, 255, universe >> 8, universe & 0xFF);
+    if (!Udp[numSockets].beginMulticast(group, E131_PORT))
+      break;
+    numSockets++;
+  }
+  return numSockets;
+}
+
+uint16_t E131::read()
+{
+  packetSize = 0;
+  readSize = 0;
+  valid = false;
+  filtered = false;
+  for (uint16_t n = 0; n < numSockets; n++)
+  {
+    EthernetUDP &udp = Udp[nextSocket];
+    if (++nextSocket == numSockets)
+      nextSocket = 0;
+    packetSize = udp.parsePacket();
+    if (packetSize > 0)
+      return parse(udp);
+  }
+  return 0;
+}
+
+uint16_t E131::parse(EthernetUDP &udp)
+{
+  remoteIP = udp.remoteIP();
+  if (packetSize < E131_SYNC_LENGTH)
+    return 0;
+  uint16_t headerSize = packetSize < E131_DMX_START ? packetSize : E131_DMX_START;
+  readSize = udp.read(header, headerSize);
+
+  // Root layer: preamble size 0x0010, no postamble, ACN packet identifier
+  if (be16(header) != 0x0010 || be16(header + 2) != 0 || memcmp(header + 4, ACN_ID, 12) != 0)
+    return 0;
+
+  uint32_t vector = be32(header + 18);
+  if (vector == VECTOR_ROOT_E131_EXTENDED)
+  {
+    if (be32(header + 40) != VECTOR_E131_EXTENDED_SYNCHRONIZATION)
+      return 0; // universe discovery, not used
+    valid = true;
+    if (syncCallback)
+      (*syncCallback)(remoteIP);
+    return E131_SYNC;
+  }
+
+  if (vector != VECTOR_ROOT_E131_DATA || packetSize < E131_DMX_START ||
+      be32(header + 40) != VECTOR_E131_DATA_PACKET ||
+      header[117] != VECTOR_DMP_SET_PROPERTY || header[118] != 0xA1)
+    return 0;
+
+  // Property values: the START code, then the channels
+  uint16_t count = be16(header + 123);
+  if (count == 0 || count - 1 > E131_MAX_CHANNELS || E131_DMX_START + count - 1 > packetSize)
+    return 0;
+  valid = true;
+
+  // Preview data is for visualizers, a terminated stream carries no frame,
+  // other START codes than 0 (per-channel priority...) are not DMX levels
+  uint8_t options = header[112];
+  if ((options & (E131_OPTION_PREVIEW | E131_OPTION_TERMINATED)) || header[125] != 0)
+    return 0;
+
+  // A sender may put other universes on our groups: drop them before
+  // copying their data, as Artnet::read() does
+  incomingUniverse = be16(header + 113);
+  if ((uint16_t)(incomingUniverse - firstUniverse) >= numSockets)
+  {
+    filtered = true;
+    return 0;
+  }
+
+  priority = header[108];
+  sequence = header[111];
+  dmxDataLength = count - 1;
+  readSize += udp.read(dataBuffer, dmxDataLength);
+  if (dataCallback)
+    (*dataCallback)(incomingUniverse, dmxDataLength, sequence, dataBuffer, remoteIP);
+  return E131_DATA;
+}
+
+e131_read_stats_s E131::readAll(uint16_t maxPackets, uint32_t budgetMicros)
+{
+  e131_read_stats_s stats = {0, 0, 0, 0};
+  uint32_t start = micros();
+
+  while (stats.packets + stats.rejects < maxPackets)
+  {
+    read();
+    if (packetSize == 0)
+      break; // every socket drained
+
+    stats.bytes += readSize;
+    if (filtered)
+      stats.filtered++;
+    else if (valid)
+      stats.packets++;
+    else
+      stats.rejects++;
+
+    if (micros() - start >= budgetMicros)
+      break;
+  }
+  return stats;
+}
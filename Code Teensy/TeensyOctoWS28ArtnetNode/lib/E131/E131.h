@@ -0,0 +1,129 @@
+/* E1.31 (sACN) receiver for the Teensy OctoWS28 Artnet Node
+
+Receives the DMX data and synchronization packets of ANSI E1.31 on the
+multicast groups of a range of universes only (239.255.hi.lo, port 5568),
+so the Ethernet controller drops the universes of the other nodes instead
+of the CPU. Same calling pattern as the Art-Net library: read() or readAll()
+from the loop, callbacks for the DMX data and the synchronization packets.
+
+Each group is received on its own socket (EthernetUDP::beginMulticast()):
+on the Teensy, NativeEthernet needs Ethernet.setSocketNum() large enough
+for the universes plus the Art-Net socket, before Ethernet.begin().
+*/
+
+#ifndef E131_H
+#define E131_H
+
+#include <Arduino.h>
+#include <NativeEthernet.h>
+#include <NativeEthernetUdp.h>
+
+// UDP specific
+#define E131_PORT 5568
+// Largest number of universes (sockets) joined by begin()
+#ifndef E131_MAX_UNIVERSES
+#define E131_MAX_UNIVERSES 32
+#endif
+// Returned by read()
+#define E131_DATA 0x0004
+#define E131_SYNC 0x0008
+// Layout of a data packet: root, framing and DMP layers, then DMX data
+#define E131_DMX_START 126
+#define E131_MAX_CHANNELS 512
+#define E131_SYNC_LENGTH 49
+// Options of the framing layer
+#define E131_OPTION_PREVIEW 0x80
+#define E131_OPTION_TERMINATED 0x40
+
+// Counters returned by E131::readAll()
+struct e131_read_stats_s
+{
+  uint16_t packets;  // E1.31 packets handled
+  uint32_t bytes;    // UDP payload bytes copied out of the sockets
+  uint16_t rejects;  // malformed or non E1.31 packets
+  uint16_t filtered; // data of other universes, only the header was read
+};
+
+class E131
+{
+public:
+  E131();
+
+  // Join the groups of count universes from firstUniverse (1 to 63999).
+  // Stops at the first group that cannot be joined (no socket or multicast
+  // membership left, or count above E131_MAX_UNIVERSES). Returns the number
+  // of groups joined: less than count is a configuration error.
+  uint16_t begin(uint16_t firstUniverse, uint16_t count);
+  // Read one packet from the next socket that has one. Returns E131_DATA
+  // or E131_SYNC if a callback was called, 0 otherwise.
+  uint16_t read();
+  // Read every pending packet, up to maxPackets or until budgetMicros elapsed
+  e131_read_stats_s readAll(uint16_t maxPackets, uint32_t budgetMicros);
+
+  // Receive the DMX data of the next packets into buffer (at least
+  // E131_MAX_CHANNELS bytes) instead of the internal one, nullptr to go
+  // back to the internal buffer
+  inline void setDataBuffer(uint8_t *buffer)
+  {
+    dataBuffer = buffer ? buffer : dmxData;
+  }
+
+  inline uint16_t getUniverse(void)
+  {
+    return incomingUniverse;
+  }
+
+  inline uint16_t getLength(void)
+  {
+    return dmxDataLength;
+  }
+
+  inline uint8_t getSequence(void)
+  {
+    return sequence;
+  }
+
+  inline uint8_t getPriority(void)
+  {
+    return priority;
+  }
+
+  inline IPAddress getRemoteIP(void)
+  {
+    return remoteIP;
+  }
+
+  inline void setDataCallback(void (*fptr)(uint16_t universe, uint16_t length, uint8_t sequence, uint8_t *data, IPAddress remoteIP))
+  {
+    dataCallback = fptr;
+  }
+
+  inline void setSyncCallback(void (*fptr)(IPAddress remoteIP))
+  {
+    syncCallback = fptr;
+  }
+
+private:
+  EthernetUDP Udp[E131_MAX_UNIVERSES];
+  uint16_t numSockets;
+  uint16_t nextSocket;
+  uint16_t firstUniverse;
+  uint8_t header[E131_DMX_START];
+  uint8_t dmxData[E131_MAX_CHANNELS];
+  uint8_t *dataBuffer;
+  uint16_t packetSize;
+  uint16_t readSize; // bytes of the last packet copied out of the socket
+  bool valid;        // last packet read was E1.31
+  bool filtered;     // last packet was data of another universe
+  uint16_t incomingUniverse;
+  uint16_t dmxDataLength;
+  uint8_t sequence;
+  uint8_t priority;
+  IPAddress remoteIP;
+  void (*dataCallback)(uint16_t universe, uint16_t length, uint8_t sequence, uint8_t *data, IPAddress remoteIP);
+  void (*syncCallback)(IPAddress remoteIP);
+
+  uint16_t parse(EthernetUDP &udp);
+};
+
+#endif
@@ -408,6 +408,69 @@ bool PixelDriver::bufferReady() {
   return ! ((ip->bm == SINGLE_BUFFER || ip->bm == DOUBLE_BUFFER) && dmaEnabled(dmaChannel));
 }
 
+bool PixelDriver::setStripSpan(uint8_t firstChannel, uint8_t numChannels, uint16_t firstPixel,
+                               uint16_t numPixels, const uint8_t *pixels, size_t channelStride,
+                               volatile uint32_t *buffer) {
+  if (! numChannels || firstChannel + numChannels > 32) return false;
+  if (firstPixel + numPixels > ip->pxls) return false;
+
+  /* Every channel of the span must use the same number of bit times per pixel */
+  const bool quad = channelTypes[firstChannel] == GRBW;
+  for (unsigned c = firstChannel; c < firstChannel + numChannels; ++c) {
+    if ((channelTypes[c] == GRBW) != quad) return false;
+  }
+  const unsigned bytesPerPixel = quad ? 4 : 3;
+  if (! channelStride) channelStride = numPixels * bytesPerPixel;
+
+  /* Channels outside the span read the first channel, the mask drops them */
+  const uint32_t mask = (numChannels == 32) ? 0xFFFFFFFF : ((1u << numChannels) - 1) << firstChannel;
+  const uint8_t *src[32];
+  for (unsigned c = 0; c < 32; ++c) {
+    src[c] = pixels;
+    if (mask & (1u << c)) src[c] += (c - firstChannel) * channelStride;
+  }
+
+  /* One bit time per word, bit n of a word drives channel n.  Each byte of a
+     pixel becomes 8 words: the bytes of 8 channels are transposed at once
+     (8x8 bit matrix, Hacker's Delight 7-3) instead of one bit at a time. */
+  uint32_t *dest = const_cast<uint32_t*>(buffer) + 8u * bytesPerPixel * firstPixel;
+  const unsigned count = numPixels * bytesPerPixel;
+  for (unsigned i = 0; i < count; ++i) {
+    uint32_t planes[8] = { 0 };
+    for (unsigned q = 0; q < 4; ++q) {
+      if (! ((mask >> (8 * q)) & 0xFF)) continue;
+      const uint8_t * const *p = src + 8 * q;
+      uint32_t x = (p[7][i] << 24) | (p[6][i] << 16) | (p[5][i] << 8) | p[4][i];
+      uint32_t y = (p[3][i] << 24) | (p[2][i] << 16) | (p[1][i] << 8) | p[0][i];
+      uint32_t t;
+      t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+      t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+      t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+      t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+      t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+      y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+      x = t;
+      /* x holds bit times 0-3 (MSB first), y bit times 4-7 */
+      const unsigned shift = 8 * q;
+      planes[0] |= ((x >> 24) & 0xFF) << shift;
+      planes[1] |= ((x >> 16) & 0xFF) << shift;
+      planes[2] |= ((x >> 8) & 0xFF) << shift;
+      planes[3] |= (x & 0xFF) << shift;
+      planes[4] |= ((y >> 24) & 0xFF) << shift;
+      planes[5] |= ((y >> 16) & 0xFF) << shift;
+      planes[6] |= ((y >> 8) & 0xFF) << shift;
+      planes[7] |= (y & 0xFF) << shift;
+    }
+    if (mask == 0xFFFFFFFF) {
+      for (unsigned j = 0; j < 8; ++j) dest[j] = planes[j];
+    } else {
+      for (unsigned j = 0; j < 8; ++j) dest[j] = (dest[j] & ~mask) | (planes[j] & mask);
+    }
+    dest += 8;
+  }
+  return true;
+}
+
 void PixelDriver::setChannelType(uint8_t channel, ChannelType type) {
   /* Allows the user to change each channel to RGB, GRB, or GRBW formatting */
   if (channel >= 32) return;
@@ -151,6 +151,27 @@ class PixelDriver
       return getPixel(channel, pixelIndex, inactiveBuffer);
     }
     
+    // Bulk import, much faster than setPixel() for whole strips.  pixels holds
+    // numChannels channels one after the other, channelStride bytes apart
+    // (0: numPixels pixels, no gap), each pixel in the order its bytes are
+    // sent (3 bytes, or 4 for GRBW channels).  All channels of the span must
+    // have the same size.  Returns false if the span is out of range.
+    bool setStripSpan(uint8_t firstChannel, uint8_t numChannels, uint16_t firstPixel,
+                      uint16_t numPixels, const uint8_t *pixels, size_t channelStride = 0) {
+      return setStripSpan(firstChannel, numChannels, firstPixel, numPixels, pixels, channelStride, activeBuffer);
+    }
+    bool setInactiveStripSpan(uint8_t firstChannel, uint8_t numChannels, uint16_t firstPixel,
+                              uint16_t numPixels, const uint8_t *pixels, size_t channelStride = 0) {
+      return setStripSpan(firstChannel, numChannels, firstPixel, numPixels, pixels, channelStride, inactiveBuffer);
+    }
+    // Whole frame: numChannels channels of the maximum pixels per strip each
+    bool setFrame(const uint8_t *pixels, uint8_t numChannels = 32) {
+      return setStripSpan(0, numChannels, 0, ip->pxls, pixels, 0, activeBuffer);
+    }
+    bool setInactiveFrame(const uint8_t *pixels, uint8_t numChannels = 32) {
+      return setStripSpan(0, numChannels, 0, ip->pxls, pixels, 0, inactiveBuffer);
+    }
+
     // for advanced buffer manipulation by user application
     volatile uint8_t* getActiveBufferPtr() { return reinterpret_cast<volatile uint8_t*>(activeBuffer); }
     volatile uint8_t* getInactiveBufferPtr() { return reinterpret_cast<volatile uint8_t*>(inactiveBuffer); }
@@ -190,6 +211,10 @@ class PixelDriver
       }
     }
     
+    bool setStripSpan(uint8_t firstChannel, uint8_t numChannels, uint16_t firstPixel,
+                      uint16_t numPixels, const uint8_t *pixels, size_t channelStride,
+                      volatile uint32_t *buffer);
+
     Color getPixel(uint8_t channel, uint16_t pixelIndex, volatile uint32_t *buffer) {
       if (channel > 31 || pixelIndex >= ip->pxls) return Color();
       
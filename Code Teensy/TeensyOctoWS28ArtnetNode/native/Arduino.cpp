@@ -0,0 +1,56 @@
+// Teensy OctoWS28 Artnet Node - host build
+// =================
+// Version: V0.2.1
+//
+// Host clock and entry point. Set NODE_RUN_SECONDS to stop after that many
+// seconds, e.g. for a benchmark in CI.
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "FastLED.h"
+#include "NativeEthernet.h"
+
+#include <time.h>
+
+HostSerial Serial;
+HostEEPROM EEPROM;
+HostEthernet Ethernet;
+CFastLED FastLED;
+
+static uint64_t nowMicros() {
+  static struct timespec start;
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  if (!start.tv_sec && !start.tv_nsec)
+    start = now;
+  return (uint64_t)(now.tv_sec - start.tv_sec) * 1000000 +
+         (now.tv_nsec - start.tv_nsec) / 1000;
+}
+
+// Wrap around like the 32 bit counters of the Teensy core
+unsigned long millis() { return (uint32_t)(nowMicros() / 1000); }
+unsigned long micros() { return (uint32_t)nowMicros(); }
+
+void delay(unsigned long ms) {
+  struct timespec t = {(time_t)(ms / 1000), (long)(ms % 1000) * 1000000};
+  nanosleep(&t, nullptr);
+}
+
+void delayMicroseconds(unsigned int us) {
+  struct timespec t = {(time_t)(us / 1000000), (long)(us % 1000000) * 1000};
+  nanosleep(&t, nullptr);
+}
+
+void yield() {}
+
+int main() {
+  setvbuf(stdout, nullptr, _IOLBF, 0);
+  nowMicros();
+  const char *seconds = getenv("NODE_RUN_SECONDS");
+  uint64_t runMicros = seconds ? (uint64_t)(atof(seconds) * 1000000) : 0;
+
+  setup();
+  while (!runMicros || nowMicros() < runMicros)
+    loop();
+  return 0;
+}
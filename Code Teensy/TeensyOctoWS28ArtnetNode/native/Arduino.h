@@ -0,0 +1,136 @@
+// Teensy OctoWS28 Artnet Node - host build
+// =================
+// Version: V0.2.1
+//
+// The part of the Arduino/Teensy core used by the node, for the `native`
+// PlatformIO env: time from the host clock, Serial on stdout, GPIO and
+// interrupts as no-ops. setup() and loop() are called by main() in
+// Arduino.cpp.
+
+#ifndef ARDUINO_H_NATIVE
+#define ARDUINO_H_NATIVE
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+
+typedef uint8_t byte;
+
+// Memory sections of the IMXRT1062 mean nothing on the host
+#define PROGMEM
+#define DMAMEM
+#define FLASHMEM
+#define FASTRUN
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define DEC 10
+#define HEX 16
+
+// Fixed MAC address for TeensyID::getMAC()
+#define HW_OCOTP_MAC1 0x04E9UL
+#define HW_OCOTP_MAC0 0xE5000001UL
+
+template <class A, class B>
+inline typename std::common_type<A, B>::type min(A a, B b) {
+  return a < b ? a : b;
+}
+template <class A, class B>
+inline typename std::common_type<A, B>::type max(A a, B b) {
+  return a > b ? a : b;
+}
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+inline void pinMode(int pin, int mode) {}
+inline void digitalWrite(int pin, int value) {}
+inline int digitalRead(int pin) { return LOW; }
+inline void __disable_irq() {}
+inline void __enable_irq() {}
+
+void setup();
+void loop();
+
+class IPAddress {
+  uint8_t bytes[4];
+
+public:
+  IPAddress() : bytes{0, 0, 0, 0} {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+  IPAddress(const uint8_t *address) { memcpy(bytes, address, 4); }
+  IPAddress(uint32_t address) { memcpy(bytes, &address, 4); }
+  uint8_t operator[](int index) const { return bytes[index]; }
+  uint8_t &operator[](int index) { return bytes[index]; }
+  operator uint32_t() const {
+    uint32_t address;
+    memcpy(&address, bytes, 4);
+    return address;
+  }
+};
+
+class Print {
+public:
+  size_t print(const char *s) { return fputs(s, stdout) < 0 ? 0 : strlen(s); }
+  size_t print(char c) { return putchar(c) < 0 ? 0 : 1; }
+  size_t print(long n, int base = DEC) {
+    return base == HEX ? printf("%lX", n) : printf("%ld", n);
+  }
+  size_t print(unsigned long n, int base = DEC) {
+    return base == HEX ? printf("%lX", n) : printf("%lu", n);
+  }
+  size_t print(int n, int base = DEC) { return print((long)n, base); }
+  size_t print(unsigned int n, int base = DEC) {
+    return print((unsigned long)n, base);
+  }
+  size_t print(double n) { return printf("%.2f", n); }
+  size_t print(const IPAddress &ip) {
+    return printf("%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+  }
+
+  size_t println() { return print('\n'); }
+  template <class T> size_t println(const T &value) {
+    size_t n = print(value);
+    return n + println();
+  }
+  template <class T> size_t println(const T &value, int base) {
+    size_t n = print(value, base);
+    return n + println();
+  }
+
+  int printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+    va_list args;
+    va_start(args, format);
+    int n = vprintf(format, args);
+    va_end(args);
+    return n;
+  }
+
+  size_t write(uint8_t c) { return print((char)c); }
+  size_t write(const uint8_t *buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+  }
+  int availableForWrite() { return 4096; }
+  void flush() { fflush(stdout); }
+};
+
+class HostSerial : public Print {
+public:
+  void begin(long baud) {}
+  void end() {}
+  operator bool() { return true; }
+  int available() { return 0; }
+  int read() { return -1; }
+};
+
+extern HostSerial Serial;
+
+#endif // ARDUINO_H_NATIVE
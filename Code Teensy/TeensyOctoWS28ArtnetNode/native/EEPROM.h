@@ -0,0 +1,25 @@
+// Teensy OctoWS28 Artnet Node - host build
+// =================
+// Version: V0.2.1
+//
+// EEPROM kept in memory, erased (0xFF) at every start like a new Teensy.
+
+#ifndef EEPROM_H_NATIVE
+#define EEPROM_H_NATIVE
+
+#include "Arduino.h"
+
+class HostEEPROM {
+  uint8_t data[4284];
+
+public:
+  HostEEPROM() { memset(data, 0xFF, sizeof(data)); }
+  uint8_t read(int address) { return data[address]; }
+  void write(int address, uint8_t value) { data[address] = value; }
+  void update(int address, uint8_t value) { data[address] = value; }
+  uint16_t length() { return sizeof(data); }
+};
+
+extern HostEEPROM EEPROM;
+
+#endif // EEPROM_H_NATIVE
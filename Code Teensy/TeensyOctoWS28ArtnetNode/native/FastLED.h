@@ -0,0 +1,151 @@
+// Teensy OctoWS28 Artnet Node - host build
+// =================
+// Version: V0.2.1
+//
+// The part of FastLED used by LEDController: CRGB, the controllers and
+// FastLED.show(), which scales the pixels by the brightness and the color
+// correction like FastLED does (no dithering).
+
+#ifndef FASTLED_H_NATIVE
+#define FASTLED_H_NATIVE
+
+#include "Arduino.h"
+
+enum EOrder { RGB = 0012, RBG = 0021, GRB = 0102, GBR = 0120, BRG = 0201,
+              BGR = 0210 };
+
+enum LEDColorCorrection {
+  TypicalSMD5050 = 0xFFB0F0,
+  TypicalLEDStrip = 0xFFB0F0,
+  Typical8mmPixel = 0xFFE08C,
+  TypicalPixelString = 0xFFE08C,
+  UncorrectedColor = 0xFFFFFF
+};
+
+struct CRGB {
+  union {
+    struct {
+      uint8_t r, g, b;
+    };
+    uint8_t raw[3];
+  };
+
+  enum HTMLColorCode {
+    Black = 0x000000,
+    Blue = 0x0000FF,
+    Green = 0x008000,
+    Red = 0xFF0000,
+    White = 0xFFFFFF
+  };
+
+  CRGB() {}
+  CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  CRGB(uint32_t colorcode)
+      : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF),
+        b(colorcode & 0xFF) {}
+};
+
+template <EOrder RGB_ORDER, int LANES = 1, uint32_t MASK = 0xFFFFFFFF>
+class PixelController {
+  const uint8_t *data;
+  int remaining;
+  uint8_t scale[3];
+
+  uint8_t loadAndScale(int channel) {
+    return (data[channel] * (scale[channel] + 1)) >> 8;
+  }
+
+public:
+  PixelController(const CRGB *leds, int count, const uint8_t *channelScale)
+      : data((const uint8_t *)leds), remaining(count) {
+    memcpy(scale, channelScale, 3);
+  }
+  bool has(int n) const { return remaining >= n; }
+  uint8_t loadAndScale0() { return loadAndScale((RGB_ORDER >> 6) & 3); }
+  uint8_t loadAndScale1() { return loadAndScale((RGB_ORDER >> 3) & 3); }
+  uint8_t loadAndScale2() { return loadAndScale(RGB_ORDER & 3); }
+  void stepDithering() {}
+  void advanceData() {
+    data += 3;
+    remaining--;
+  }
+};
+
+class CLEDController {
+  CLEDController *next;
+  friend class CFastLED;
+
+protected:
+  CRGB *m_Data;
+  int m_nLeds;
+  CRGB m_ColorCorrection;
+
+public:
+  CLEDController()
+      : next(nullptr), m_Data(nullptr), m_nLeds(0),
+        m_ColorCorrection(UncorrectedColor) {}
+  virtual ~CLEDController() {}
+  virtual void init() = 0;
+  virtual void show(const CRGB *data, int count, const uint8_t *scale) = 0;
+
+  CLEDController &setLeds(CRGB *data, int count) {
+    m_Data = data;
+    m_nLeds = count;
+    return *this;
+  }
+  CLEDController &setCorrection(uint32_t correction) {
+    m_ColorCorrection = CRGB(correction);
+    return *this;
+  }
+  CRGB *leds() { return m_Data; }
+  int size() const { return m_nLeds; }
+  const CRGB &getCorrection() const { return m_ColorCorrection; }
+};
+
+template <EOrder RGB_ORDER, int LANES = 1, uint32_t MASK = 0xFFFFFFFF>
+class CPixelLEDController : public CLEDController {
+public:
+  virtual void showPixels(PixelController<RGB_ORDER, LANES, MASK> &pixels) = 0;
+
+  void show(const CRGB *data, int count, const uint8_t *scale) override {
+    PixelController<RGB_ORDER, LANES, MASK> pixels(data, count, scale);
+    showPixels(pixels);
+  }
+};
+
+class CFastLED {
+  CLEDController *head;
+  uint8_t brightness;
+
+public:
+  CFastLED() : head(nullptr), brightness(255) {}
+
+  CLEDController &addLeds(CLEDController *controller, CRGB *data, int count) {
+    controller->next = head;
+    head = controller;
+    controller->init();
+    return controller->setLeds(data, count);
+  }
+
+  void setBrightness(uint8_t scale) { brightness = scale; }
+  uint8_t getBrightness() const { return brightness; }
+
+  void show() {
+    for (CLEDController *c = head; c; c = c->next) {
+      const CRGB &k = c->getCorrection();
+      const uint8_t scale[3] = {(uint8_t)((k.r * (brightness + 1)) >> 8),
+                                (uint8_t)((k.g * (brightness + 1)) >> 8),
+                                (uint8_t)((k.b * (brightness + 1)) >> 8)};
+      c->show(c->leds(), c->size(), scale);
+    }
+  }
+
+  void delay(unsigned long ms) {
+    show();
+    ::delay(ms);
+  }
+};
+
+extern CFastLED FastLED;
+
+#endif // FASTLED_H_NATIVE
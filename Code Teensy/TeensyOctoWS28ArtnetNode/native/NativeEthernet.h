@@ -0,0 +1,30 @@
+// Teensy OctoWS28 Artnet Node - host build
+// =================
+// Version: V0.2.1
+//
+// The host network is already up: begin() only records the address given,
+// the sockets of NativeEthernetUdp.h listen on every interface.
+
+#ifndef NATIVEETHERNET_H_NATIVE
+#define NATIVEETHERNET_H_NATIVE
+
+#include "Arduino.h"
+#include "NativeEthernetUdp.h"
+
+class HostEthernet {
+  IPAddress address;
+  IPAddress subnet;
+
+public:
+  void begin(uint8_t *mac, IPAddress ip) { address = ip; }
+  void begin(uint8_t *mac, uint8_t *ip) { address = IPAddress(ip); }
+  void setSubnetMask(IPAddress mask) { subnet = mask; }
+  void setSocketNum(uint8_t number) {}
+  void setSocketSize(size_t bytes) {}
+  IPAddress localIP() { return address; }
+  IPAddress subnetMask() { return subnet; }
+};
+
+extern HostEthernet Ethernet;
+
+#endif // NATIVEETHERNET_H_NATIVE
@@ -0,0 +1,116 @@
+// Teensy OctoWS28 Artnet Node - host build
+// =================
+// Version: V0.2.1
+
+#include "NativeEthernetUdp.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+EthernetUDP::EthernetUDP()
+    : fd(-1), rxSize(0), rxPos(0), rxPort(0), txSize(0), txPort(0) {}
+
+uint8_t EthernetUDP::begin(uint16_t port) {
+  return open(htonl(INADDR_ANY), port);
+}
+
+uint8_t EthernetUDP::open(uint32_t address, uint16_t port) {
+  stop();
+  fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0)
+    return 0;
+  int on = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+  // Art-Net senders send bursts of universes, keep them all
+  int size = 4 << 20;
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = address;
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    perror("EthernetUDP::begin");
+    stop();
+    return 0;
+  }
+  return 1;
+}
+
+uint8_t EthernetUDP::beginMulticast(IPAddress group, uint16_t port) {
+  // Bound to the group, the socket only gets the datagrams of its own group
+  // like a NativeEthernet socket, not those of the groups of other sockets
+  if (!open((uint32_t)group, port))
+    return 0;
+  struct ip_mreq mreq = {};
+  mreq.imr_multiaddr.s_addr = (uint32_t)group;
+  mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+  return setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) ==
+         0;
+}
+
+void EthernetUDP::stop() {
+  if (fd >= 0)
+    close(fd);
+  fd = -1;
+  rxSize = rxPos = 0;
+}
+
+int EthernetUDP::parsePacket() {
+  // The rest of the previous datagram is dropped, as in NativeEthernet
+  rxSize = rxPos = 0;
+  if (fd < 0)
+    return 0;
+  struct sockaddr_in from;
+  socklen_t fromLen = sizeof(from);
+  ssize_t n = recvfrom(fd, rxBuffer, sizeof(rxBuffer), 0,
+                       (struct sockaddr *)&from, &fromLen);
+  if (n <= 0)
+    return 0;
+  rxSize = n;
+  rxIP = IPAddress((uint32_t)from.sin_addr.s_addr);
+  rxPort = ntohs(from.sin_port);
+  return rxSize;
+}
+
+int EthernetUDP::read() {
+  return available() ? rxBuffer[rxPos++] : -1;
+}
+
+int EthernetUDP::read(uint8_t *buffer, size_t size) {
+  int n = available();
+  if ((size_t)n > size)
+    n = size;
+  memcpy(buffer, rxBuffer + rxPos, n);
+  rxPos += n;
+  return n;
+}
+
+int EthernetUDP::beginPacket(IPAddress ip, uint16_t port) {
+  txIP = ip;
+  txPort = port;
+  txSize = 0;
+  return fd >= 0;
+}
+
+size_t EthernetUDP::write(const uint8_t *buffer, size_t size) {
+  if (size > sizeof(txBuffer) - txSize)
+    size = sizeof(txBuffer) - txSize;
+  memcpy(txBuffer + txSize, buffer, size);
+  txSize += size;
+  return size;
+}
+
+int EthernetUDP::endPacket() {
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(txPort);
+  addr.sin_addr.s_addr = (uint32_t)txIP;
+  return sendto(fd, txBuffer, txSize, 0, (struct sockaddr *)&addr,
+                sizeof(addr)) == txSize;
+}
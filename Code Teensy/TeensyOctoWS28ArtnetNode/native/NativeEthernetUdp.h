@@ -0,0 +1,51 @@
+// Teensy OctoWS28 Artnet Node - host build
+// =================
+// Version: V0.2.1
+//
+// EthernetUDP on a non-blocking POSIX socket. parsePacket() receives a whole
+// datagram, read() copies it out like the NativeEthernet buffer does.
+
+#ifndef NATIVEETHERNETUDP_H_NATIVE
+#define NATIVEETHERNETUDP_H_NATIVE
+
+#include "Arduino.h"
+
+class EthernetUDP {
+  int fd;
+  uint8_t rxBuffer[2048];
+  int rxSize;
+  int rxPos;
+  IPAddress rxIP;
+  uint16_t rxPort;
+  uint8_t txBuffer[2048];
+  int txSize;
+  IPAddress txIP;
+  uint16_t txPort;
+
+  uint8_t open(uint32_t address, uint16_t port);
+
+public:
+  EthernetUDP();
+  ~EthernetUDP() { stop(); }
+
+  uint8_t begin(uint16_t port);
+  uint8_t beginMulticast(IPAddress group, uint16_t port);
+  void stop();
+
+  int parsePacket();
+  int available() { return rxSize - rxPos; }
+  int read();
+  int read(uint8_t *buffer, size_t size);
+  int read(char *buffer, size_t size) { return read((uint8_t *)buffer, size); }
+  int peek() { return available() ? rxBuffer[rxPos] : -1; }
+  void flush() { rxPos = rxSize; }
+  IPAddress remoteIP() { return rxIP; }
+  uint16_t remotePort() { return rxPort; }
+
+  int beginPacket(IPAddress ip, uint16_t port);
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size);
+  int endPacket();
+};
+
+#endif // NATIVEETHERNETUDP_H_NATIVE
@@ -0,0 +1,28 @@
+// Teensy OctoWS28 Artnet Node - host build
+// =================
+// Version: V0.2.1
+//
+// Only the WS2811_* configuration values of OctoWS2811: the node describes
+// the color order of every output with them (OutputCapabilities::colorOrder).
+
+#ifndef OCTOWS2811_H_NATIVE
+#define OCTOWS2811_H_NATIVE
+
+#define WS2811_RGB 0
+#define WS2811_RBG 1
+#define WS2811_GRB 2
+#define WS2811_GBR 3
+#define WS2811_BRG 4
+#define WS2811_BGR 5
+#define WS2811_RGBW 6
+#define WS2811_RBGW 7
+#define WS2811_GRBW 8
+#define WS2811_GBRW 9
+#define WS2811_BRGW 10
+#define WS2811_BGRW 11
+
+#define WS2811_800kHz 0x00
+#define WS2811_400kHz 0x40
+#define WS2813_800kHz 0x80
+
+#endif // OCTOWS2811_H_NATIVE
@@ -0,0 +1,5 @@
+// Teensy OctoWS28 Artnet Node - host build
+// =================
+// Version: V0.2.1
+//
+// Included by main.cpp, nothing of it is used.
@@ -0,0 +1,236 @@
+/**
+ * @file ColorKernel.h
+ * @brief Fichier d'en-tête pour la classe ColorKernel.
+ * @details Conversion des pixels RGB en une seule passe : luminosité, balance
+ * des couleurs, courbes gamma (rg8, gg8, bg8), extraction du blanc et ordre
+ * des couleurs de la bande. Tout ce qui dépend de la valeur d'un canal est
+ * précalculé dans des tables, recalculées uniquement quand la luminosité, la
+ * balance ou les courbes changent.
+ * @version V0.2.1
+ * @date 2026
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ * Ce programme est un logiciel libre : vous pouvez le redistribuer et/ou le
+ * modifier selon les termes de la Licence Publique Générale GNU publiée par la
+ * Free Software Foundation, soit la version 3 de la licence, soit (à votre
+ * choix) toute version ultérieure.
+ *
+ * Ce programme est distribué dans l'espoir qu'il sera utile,
+ * mais SANS AUCUNE GARANTIE ; sans même la garantie implicite de
+ * QUALITÉ MARCHANDE ou d'ADÉQUATION À UN USAGE PARTICULIER. Voir la
+ * Licence Publique Générale GNU pour plus de détails.
+ *
+ * Vous devriez avoir reçu une copie de la Licence Publique Générale GNU
+ * avec ce programme. Si ce n'est pas le cas, voir
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLORKERNEL_H
+#define COLORKERNEL_H
+
+#include <Arduino.h>
+
+#include "gamma8.h"
+
+/**
+ * @class ColorKernel
+ * @brief Convertit des pixels RGB dans le format de sortie de la bande.
+ */
+class ColorKernel {
+  uint8_t lut[3][256]; // valeur de sortie de R, G et B pour chaque entrée
+  uint8_t brightness;
+  uint8_t balance[3];
+  bool curves;
+  bool rgbw;
+  uint8_t bytesPerPixel;
+  uint8_t channelOffset[4]; // position de R, G, B et W dans un pixel
+
+  /**
+   * @brief Recalculer les tables de conversion.
+   */
+  void rebuild();
+
+  /**
+   * @brief Boucle de conversion, spécialisée pour chaque format de pixel.
+   */
+  template <uint8_t BPP, bool WHITE>
+  void convert(const uint8_t *src, uint8_t *dest, uint16_t count,
+               uint32_t *sums) const;
+
+public:
+  /**
+   * @brief Constructeur pour ColorKernel (RGB, sans courbe ni correction).
+   */
+  ColorKernel();
+
+  /**
+   * @brief Définir l'ordre des couleurs de la bande.
+   * @param config Configuration passée à OctoWS2811 (WS2811_GRBW...).
+   */
+  void setOrder(uint8_t config);
+
+  /**
+   * @brief Définir la luminosité.
+   * @param _brightness Luminosité de 0 à 255.
+   */
+  void setBrightness(uint8_t _brightness);
+
+  /**
+   * @brief Définir la balance des couleurs.
+   * @param r Gain de la composante rouge de 0 à 255.
+   * @param g Gain de la composante verte de 0 à 255.
+   * @param b Gain de la composante bleue de 0 à 255.
+   */
+  void setBalance(uint8_t r, uint8_t g, uint8_t b);
+
+  /**
+   * @brief Activer les courbes gamma rg8, gg8 et bg8 de gamma8.h.
+   * @param enabled True pour appliquer les courbes.
+   */
+  void setCurves(bool enabled);
+
+  /**
+   * @brief Extraire le blanc des composantes RGB (bandes RGBW).
+   * @param enabled True si la bande est RGBW.
+   */
+  void setRGBW(bool enabled) { rgbw = enabled; }
+
+  /**
+   * @brief Retourner le nombre d'octets d'un pixel en sortie (3 ou 4).
+   */
+  uint8_t getBytesPerPixel() const { return bytesPerPixel; }
+
+  /**
+   * @brief Convertir des pixels RGB.
+   * @param src Pixels RGB, 3 octets par pixel.
+   * @param dest Tampon de sortie, getBytesPerPixel() octets par pixel.
+   * @param count Nombre de pixels.
+   * @param sums Si non nul, les valeurs de sortie de R, G, B et W sont
+   * ajoutées à sums[0..3] (estimation de la consommation, voir PowerBudget).
+   */
+  void apply(const uint8_t *src, uint8_t *dest, uint16_t count,
+             uint32_t *sums = nullptr) const;
+
+  /**
+   * @brief Convertir un seul pixel RGB.
+   * @param dest Pixel de sortie.
+   */
+  void apply(uint8_t r, uint8_t g, uint8_t b, uint8_t *dest) const {
+    const uint8_t src[3] = {r, g, b};
+    apply(src, dest, 1);
+  }
+};
+
+ColorKernel::ColorKernel()
+    : brightness(255), balance{255, 255, 255}, curves(false), rgbw(false),
+      bytesPerPixel(3), channelOffset{0, 1, 2, 3} {
+  rebuild();
+}
+
+void ColorKernel::setOrder(uint8_t config) {
+  // Ordre des couleurs pour chaque valeur WS2811_* d'OctoWS2811
+  static const char orders[30][5] = {
+      "RGB",  "RBG",  "GRB",  "GBR",  "BRG",  "BGR",  "RGBW", "RBGW",
+      "GRBW", "GBRW", "BRGW", "BGRW", "WRGB", "WRBG", "WGRB", "WGBR",
+      "WBRG", "WBGR", "RWGB", "RWBG", "GWRB", "GWBR", "BWRG", "BWGR",
+      "RGWB", "RBWG", "GRWB", "GBWR", "BRWG", "BGWR"};
+  static const char colors[] = "RGBW";
+
+  uint8_t order = config & 0x1F;
+  if (order >= 30)
+    return;
+  bytesPerPixel = order < 6 ? 3 : 4;
+  for (uint8_t pos = 0; pos < bytesPerPixel; pos++)
+    channelOffset[strchr(colors, orders[order][pos]) - colors] = pos;
+}
+
+void ColorKernel::setBrightness(uint8_t _brightness) {
+  if (_brightness == brightness)
+    return;
+  brightness = _brightness;
+  rebuild();
+}
+
+void ColorKernel::setBalance(uint8_t r, uint8_t g, uint8_t b) {
+  if (r == balance[0] && g == balance[1] && b == balance[2])
+    return;
+  balance[0] = r;
+  balance[1] = g;
+  balance[2] = b;
+  rebuild();
+}
+
+void ColorKernel::setCurves(bool enabled) {
+  if (enabled == curves)
+    return;
+  curves = enabled;
+  rebuild();
+}
+
+void ColorKernel::rebuild() {
+  for (uint8_t c = 0; c < 3; c++) {
+    // Même ordre que le noeud ObjectFLED : luminosité et balance (FastLED),
+    // puis courbe gamma de la composante
+    uint16_t scale = ((brightness + 1) * (balance[c] + 1)) >> 8;
+    for (uint16_t x = 0; x < 256; x++) {
+      uint8_t v = (x * scale) >> 8;
+      if (curves)
+        v = c == 0 ? rg8(v) : c == 1 ? gg8(v) : bg8(v);
+      lut[c][x] = v;
+    }
+  }
+}
+
+template <uint8_t BPP, bool WHITE>
+void ColorKernel::convert(const uint8_t *src, uint8_t *dest, uint16_t count,
+                          uint32_t *sums) const {
+  const uint8_t ro = channelOffset[0], go = channelOffset[1],
+                bo = channelOffset[2], wo = channelOffset[3];
+  const uint8_t *lr = lut[0], *lg = lut[1], *lb = lut[2];
+  // Les sommes restent dans des registres, quelques additions par pixel
+  uint32_t sr = 0, sg = 0, sb = 0, sw = 0;
+
+  while (count--) {
+    uint8_t r = lr[src[0]];
+    uint8_t g = lg[src[1]];
+    uint8_t b = lb[src[2]];
+    src += 3;
+    if (BPP == 4) {
+      uint8_t w = 0;
+      if (WHITE) {
+        w = min(r, min(g, b));
+        r -= w;
+        g -= w;
+        b -= w;
+      }
+      dest[wo] = w;
+      sw += w;
+    }
+    dest[ro] = r;
+    dest[go] = g;
+    dest[bo] = b;
+    sr += r;
+    sg += g;
+    sb += b;
+    dest += BPP;
+  }
+  if (sums) {
+    sums[0] += sr;
+    sums[1] += sg;
+    sums[2] += sb;
+    sums[3] += sw;
+  }
+}
+
+void ColorKernel::apply(const uint8_t *src, uint8_t *dest, uint16_t count,
+                        uint32_t *sums) const {
+  if (bytesPerPixel == 3)
+    convert<3, false>(src, dest, count, sums);
+  else if (rgbw)
+    convert<4, true>(src, dest, count, sums);
+  else
+    convert<4, false>(src, dest, count, sums);
+}
+
+#endif // COLORKERNEL_H
@@ -1,7 +1,8 @@
 /**
  * @file Debug.h
  * @brief Fichier d'en-tête pour la classe Debug.
- * @details Une classe pour gérer les messages de débogage.
+ * @details Une classe pour gérer les messages de débogage : niveaux choisis à
+ * la compilation et journal binaire des événements de la réception.
  * @version V0.2.1
  * @date 2023
  * 
@@ -24,12 +25,69 @@
 #define DEBUG_H
 
 #include <Arduino.h>
+#include <stdarg.h>
+
+// Niveaux des messages, choisis à la compilation (-D DEBUG_LEVEL=...). Les
+// messages au-dessus du niveau choisi ne sont pas compilés.
+#define DEBUG_LEVEL_NONE 0
+#define DEBUG_LEVEL_ERROR 1 // erreurs de configuration
+#define DEBUG_LEVEL_INFO 2  // démarrage et statistiques
+#define DEBUG_LEVEL_TRACE 3 // événements de la réception, par le journal
+#ifndef DEBUG_LEVEL
+#define DEBUG_LEVEL DEBUG_LEVEL_INFO
+#endif
+
+// Nombre d'événements en attente dans le journal (puissance de 2)
+#ifndef DEBUG_LOG_SIZE
+#define DEBUG_LOG_SIZE 256
+#endif
+
+// Longueur maximum d'un message formaté
+#define DEBUG_LINE_SIZE 192
+
+/**
+ * @brief Événements du journal binaire, avec leurs valeurs a, b et c.
+ */
+enum DebugEvent : uint16_t {
+  DEBUG_EVENT_UNIVERSE,     // univers reçu : univers, longueur, univers reçus
+  DEBUG_EVENT_FRAME,        // trame envoyée : numéro
+  DEBUG_EVENT_SYNC_MODE,    // premier ArtSync
+  DEBUG_EVENT_SYNC_TIMEOUT, // plus d'ArtSync
+  DEBUG_EVENT_PIXELS,       // paquet ART_PIXEL : trame, premier pixel, pixels
+  DEBUG_EVENT_COUNT
+};
+
+/**
+ * @struct DebugRecord
+ * @brief Un événement du journal, formaté plus tard par Debug::flush().
+ */
+struct DebugRecord {
+  uint32_t time; // micros()
+  uint16_t event;
+  uint16_t a;
+  uint16_t b;
+  uint16_t c;
+};
 
 /**
  * @class Debug
  * @brief Classe pour gérer les messages de débogage.
+ * @details Utiliser les macros DEBUG_ERROR(), DEBUG_INFO() et DEBUG_TRACE()
+ * pour que les messages disparaissent selon DEBUG_LEVEL. DEBUG_TRACE() ne
+ * fait qu'ajouter un événement au journal binaire (quelques cycles, sans
+ * Serial) : il est appelé pour chaque paquet, Debug::flush() l'écrit quand la
+ * boucle n'a plus rien à faire.
  */
 class Debug {
+#if DEBUG_LEVEL >= DEBUG_LEVEL_TRACE
+  static DebugRecord records[DEBUG_LOG_SIZE];
+  static volatile uint16_t logHead; // écrit uniquement par log()
+  static volatile uint16_t logTail; // écrit uniquement par flush()
+  static volatile uint32_t logLost;
+  static uint32_t logLostPrinted;
+  static const char *const eventFormats[DEBUG_EVENT_COUNT];
+#endif
+
 public:
   static bool DEBUG;
 
@@ -101,19 +159,117 @@ public:
 
   /**
    * @brief Imprimer un message formaté.
+   * @details Le message est tronqué à DEBUG_LINE_SIZE - 1 caractères.
    * @param format Le format du message.
    * @param ... Les arguments du message.
    */
-  static void printf(const char* format, ...) {
+  static void printf(const char* format, ...)
+      __attribute__((format(printf, 1, 2))) {
     if (DEBUG) {
+      char line[DEBUG_LINE_SIZE];
       va_list args;
       va_start(args, format);
-      Serial.printf(format, args);
+      vsnprintf(line, sizeof(line), format, args);
       va_end(args);
+      Serial.print(line);
     }
   }
+
+#if DEBUG_LEVEL >= DEBUG_LEVEL_TRACE
+  /**
+   * @brief Ajouter un événement au journal binaire.
+   * @details Sans verrou : un seul producteur (la boucle, ou une
+   * interruption) et un seul consommateur, flush(). Si le journal est plein,
+   * l'événement est perdu et compté.
+   * @param event Événement.
+   * @param a Première valeur de l'événement.
+   * @param b Deuxième valeur de l'événement.
+   * @param c Troisième valeur de l'événement.
+   */
+  static void log(DebugEvent event, uint16_t a, uint16_t b, uint16_t c) {
+    uint16_t h = logHead;
+    if ((uint16_t)(h - logTail) >= DEBUG_LOG_SIZE) {
+      logLost = logLost + 1;
+      return;
+    }
+    DebugRecord &record = records[h & (DEBUG_LOG_SIZE - 1)];
+    record.time = micros();
+    record.event = event;
+    record.a = a;
+    record.b = b;
+    record.c = c;
+    logHead = h + 1; // publier l'événement une fois qu'il est complet
+  }
+
+  /**
+   * @brief Formater et imprimer les événements en attente du journal.
+   * @details À appeler quand la boucle n'a rien d'autre à faire. S'arrête dès
+   * que le tampon d'envoi de Serial n'a plus de place pour une ligne, pour ne
+   * jamais bloquer : les événements restants attendent l'appel suivant.
+   */
+  static void flush() {
+    static_assert((DEBUG_LOG_SIZE & (DEBUG_LOG_SIZE - 1)) == 0,
+                  "DEBUG_LOG_SIZE doit être une puissance de 2");
+    uint16_t t = logTail;
+    while (t != logHead && Serial.availableForWrite() >= DEBUG_LINE_SIZE) {
+      const DebugRecord &record = records[t & (DEBUG_LOG_SIZE - 1)];
+      printf(eventFormats[record.event], (unsigned long)record.time,
+             record.a, record.b, record.c);
+      logTail = ++t;
+    }
+    uint32_t lost = logLost;
+    if (lost != logLostPrinted &&
+        Serial.availableForWrite() >= DEBUG_LINE_SIZE) {
+      printf("%lu events lost\n", (unsigned long)(lost - logLostPrinted));
+      logLostPrinted = lost;
+    }
+  }
+#endif
+};
+
+bool Debug::DEBUG = false;
+
+#if DEBUG_LEVEL >= DEBUG_LEVEL_TRACE
+DebugRecord Debug::records[DEBUG_LOG_SIZE];
+volatile uint16_t Debug::logHead = 0;
+volatile uint16_t Debug::logTail = 0;
+volatile uint32_t Debug::logLost = 0;
+uint32_t Debug::logLostPrinted = 0;
+// Arguments : micros(), a, b et c de l'événement
+const char *const Debug::eventFormats[DEBUG_EVENT_COUNT] = {
+    "%lu us\tuniverse number = %u\tdata length = %u\treceived = %u\n",
+    "%lu us\tframe %u sent\n",
+    "%lu us\tArtSync mode\n",
+    "%lu us\tArtSync timeout\n",
+    "%lu us\tpixel frame = %u\tfirst pixel = %u\tpixels = %u\n",
 };
+#endif
+
+// Message non compilé : les arguments restent vérifiés et utilisés
+#define DEBUG_NOTHING(...)                                                     \
+  do {                                                                         \
+    if (0)                                                                     \
+      Debug::printf(__VA_ARGS__);                                              \
+  } while (0)
+
+#if DEBUG_LEVEL >= DEBUG_LEVEL_ERROR
+#define DEBUG_ERROR(...) Debug::printf(__VA_ARGS__)
+#else
+#define DEBUG_ERROR(...) DEBUG_NOTHING(__VA_ARGS__)
+#endif
+
+#if DEBUG_LEVEL >= DEBUG_LEVEL_INFO
+#define DEBUG_INFO(...) Debug::printf(__VA_ARGS__)
+#else
+#define DEBUG_INFO(...) DEBUG_NOTHING(__VA_ARGS__)
+#endif
 
-bool Debug::DEBUG = true;
+#if DEBUG_LEVEL >= DEBUG_LEVEL_TRACE
+#define DEBUG_TRACE(event, a, b, c) Debug::log(event, a, b, c)
+#define DEBUG_FLUSH() Debug::flush()
+#else
+#define DEBUG_TRACE(event, a, b, c) ((void)0)
+#define DEBUG_FLUSH() ((void)0)
+#endif
 
 #endif // DEBUG_H
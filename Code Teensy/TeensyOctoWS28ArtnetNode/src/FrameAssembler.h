@@ -0,0 +1,403 @@
+/**
+ * @file FrameAssembler.h
+ * @brief Fichier d'en-tête pour la classe FrameAssembler.
+ * @details Suivi des univers reçus pour une trame et placement des pixels de
+ * chaque univers, indépendamment de l'ordre d'arrivée des paquets. Les
+ * paquets en retard sont écartés grâce au numéro de séquence Artnet. Une
+ * trame peut aussi arriver en paquets de pixels (ART_PIXEL), placés par leur
+ * index de premier pixel.
+ * @version V0.2.1
+ * @date 2026
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ * Ce programme est un logiciel libre : vous pouvez le redistribuer et/ou le
+ * modifier selon les termes de la Licence Publique Générale GNU publiée par la
+ * Free Software Foundation, soit la version 3 de la licence, soit (à votre
+ * choix) toute version ultérieure.
+ *
+ * Ce programme est distribué dans l'espoir qu'il sera utile,
+ * mais SANS AUCUNE GARANTIE ; sans même la garantie implicite de
+ * QUALITÉ MARCHANDE ou d'ADÉQUATION À UN USAGE PARTICULIER. Voir la
+ * Licence Publique Générale GNU pour plus de détails.
+ *
+ * Vous devriez avoir reçu une copie de la Licence Publique Générale GNU
+ * avec ce programme. Si ce n'est pas le cas, voir
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAMEASSEMBLER_H
+#define FRAMEASSEMBLER_H
+
+#include <Arduino.h>
+
+// Nombre maximum d'univers par trame
+#ifndef FRAME_ASSEMBLER_MAX_UNIVERSES
+#define FRAME_ASSEMBLER_MAX_UNIVERSES 64
+#endif
+#define FRAME_ASSEMBLER_MASK_WORDS ((FRAME_ASSEMBLER_MAX_UNIVERSES + 31) / 32)
+// Nombre maximum de LEDs d'une trame ART_PIXEL
+#ifndef FRAME_ASSEMBLER_MAX_PIXELS
+#define FRAME_ASSEMBLER_MAX_PIXELS 8192
+#endif
+#define FRAME_ASSEMBLER_PIXEL_WORDS ((FRAME_ASSEMBLER_MAX_PIXELS + 31) / 32)
+
+// Un paquet dont la séquence (ou le numéro de trame ART_PIXEL) est en retard
+// de moins de cette valeur sur le dernier paquet du même univers est écarté.
+// Au-delà, on considère que l'émetteur a redémarré.
+#define SEQUENCE_STALE_WINDOW 64
+// Après ce nombre de paquets écartés à la suite, l'émetteur a redémarré
+// dans la fenêtre : les séquences reçues sont oubliées.
+#define SEQUENCE_RESYNC_REJECTS 4
+
+/**
+ * @struct FrameStats
+ * @brief Compteurs de l'assemblage des trames.
+ */
+struct FrameStats {
+  uint32_t frames;        // trames complètes
+  uint32_t framesDropped; // trames abandonnées avant d'être complètes
+  uint32_t lostUniverses; // univers manquants dans les trames abandonnées
+  uint32_t lostPixels;    // pixels manquants dans les trames ART_PIXEL abandonnées
+  uint32_t reordered;     // paquets écartés car en retard ou en double
+  uint32_t lostPackets;   // paquets sautés dans la séquence (perdus en route)
+};
+
+/**
+ * @class FrameAssembler
+ * @brief Assemble les univers d'une trame avec un masque de bits.
+ * @details La position de chaque univers est précalculée dans une table,
+ * le coût par paquet est constant quel que soit le nombre d'univers.
+ */
+class FrameAssembler {
+  uint16_t startUniverse;
+  uint16_t numUniverses;
+  uint16_t numLeds;
+  uint16_t pixelOffset[FRAME_ASSEMBLER_MAX_UNIVERSES + 1];
+  uint32_t receivedMask[FRAME_ASSEMBLER_MASK_WORDS];
+  uint16_t receivedCount;
+  uint32_t generation;
+  uint8_t lastSequence[FRAME_ASSEMBLER_MAX_UNIVERSES];
+  uint8_t frameSequence; // séquence du premier univers de la trame en cours
+  uint8_t staleCount;    // paquets écartés à la suite
+  uint16_t pixelFrame;     // numéro de la trame ART_PIXEL en cours
+  uint16_t pixelsReceived; // pixels reçus de la trame ART_PIXEL en cours
+  uint32_t pixelMask[FRAME_ASSEMBLER_PIXEL_WORDS]; // un bit par pixel reçu
+  uint16_t pixelsExpected; // fin de la trame, connue au paquet ART_PIXEL_LAST
+  bool pixelFrameDone;     // la trame pixelFrame est complète et affichée
+  uint8_t lastPixelSequence;
+  FrameStats stats;
+
+  /**
+   * @brief Écarter un paquet en retard ou en double, compter les paquets
+   * sautés.
+   * @param last Séquence du dernier paquet accepté, mise à jour.
+   * @return False si le paquet est en retard.
+   */
+  bool checkSequence(uint8_t &last, uint8_t sequence);
+
+  /**
+   * @brief Compter un paquet en retard.
+   * @return True si le paquet est écarté, false si trop de paquets ont été
+   * écartés à la suite : les séquences sont oubliées et le paquet accepté.
+   */
+  bool rejectStale();
+
+  /**
+   * @brief Abandonner la trame d'univers en cours pour en commencer une
+   * autre.
+   */
+  void dropFrame();
+
+  /**
+   * @brief Compter les pixels d'une plage pas encore reçus.
+   * @param mark True pour marquer aussi la plage comme reçue.
+   */
+  uint16_t coverPixels(uint16_t firstPixel, uint16_t pixelCount, bool mark);
+
+public:
+  /**
+   * @brief Constructeur pour FrameAssembler.
+   */
+  FrameAssembler();
+
+  /**
+   * @brief Configurer les univers d'une trame.
+   * @param _startUniverse Numéro du premier univers.
+   * @param _numUniverses Nombre d'univers par trame.
+   * @param pixelsPerUniverse Nombre de pixels RGB dans un univers (170 pour
+   * 510 canaux).
+   * @param _numLeds Nombre total de LEDs de la trame.
+   * @return False si le nombre d'univers dépasse
+   * FRAME_ASSEMBLER_MAX_UNIVERSES ou le nombre de LEDs
+   * FRAME_ASSEMBLER_MAX_PIXELS.
+   */
+  bool begin(uint16_t _startUniverse, uint16_t _numUniverses,
+             uint16_t pixelsPerUniverse, uint16_t _numLeds);
+
+  /**
+   * @brief Ajouter un univers à la trame en cours.
+   * @details Un univers déjà reçu dans la trame en cours, ou une séquence
+   * plus récente que celle du premier univers de la trame, signifie que
+   * l'émetteur est passé à la trame suivante : la trame incomplète est
+   * abandonnée pour ne jamais mélanger deux trames source. Un univers d'une
+   * séquence plus ancienne est écarté.
+   * @param universe Numéro de l'univers.
+   * @param length Longueur des données DMX.
+   * @param sequence Numéro de séquence Artnet (0 si désactivé).
+   * @param firstPixel Index du premier pixel de l'univers dans la trame.
+   * @param pixelCount Nombre de pixels à copier depuis les données.
+   * @return False si l'univers n'appartient pas à cette trame ou si le
+   * paquet est en retard.
+   */
+  bool add(uint16_t universe, uint16_t length, uint8_t sequence,
+           uint16_t &firstPixel, uint16_t &pixelCount);
+
+  /**
+   * @brief Ajouter un paquet de pixels (ART_PIXEL) à la trame en cours.
+   * @details Un autre numéro de trame signifie que l'émetteur est passé à la
+   * trame suivante : la trame incomplète est abandonnée. La trame est
+   * complète quand le paquet ART_PIXEL_LAST et tous les pixels qui le
+   * précèdent ont été reçus. Les pixels sont suivis par un masque de bits :
+   * un paquet en double ou qui chevauche un autre ne compte que ses pixels
+   * nouveaux. Un paquet de la trame qui vient d'être complétée ou d'une
+   * trame plus ancienne est écarté.
+   * @param frame Numéro de trame.
+   * @param firstPixel Index du premier pixel du paquet dans la trame.
+   * @param length Longueur des données RGB.
+   * @param sequence Numéro de séquence (0 si désactivé).
+   * @param last True pour le dernier paquet de la trame.
+   * @param pixelCount Nombre de pixels à copier depuis les données.
+   * @return False si le paquet est en retard.
+   */
+  bool addPixels(uint16_t frame, uint16_t firstPixel, uint16_t length,
+                 uint8_t sequence, bool last, uint16_t &pixelCount);
+
+  /**
+   * @brief Retourner true si tous les univers (ou tous les pixels) de la
+   * trame ont été reçus.
+   */
+  bool isComplete() const {
+    return (numUniverses && receivedCount == numUniverses) ||
+           (pixelsExpected && pixelsReceived >= pixelsExpected);
+  }
+
+  /**
+   * @brief Retourner le nombre d'univers reçus (popcount du masque).
+   */
+  uint16_t received() const;
+
+  /**
+   * @brief Commencer une nouvelle trame.
+   */
+  void reset();
+
+  /**
+   * @brief Retourner le numéro de la trame en cours d'assemblage.
+   */
+  uint32_t getGeneration() const { return generation; }
+
+  /**
+   * @brief Retourner le nombre d'univers par trame.
+   */
+  uint16_t getNumUniverses() const { return numUniverses; }
+
+  /**
+   * @brief Retourner les compteurs de l'assemblage.
+   */
+  const FrameStats &getStats() const { return stats; }
+};
+
+FrameAssembler::FrameAssembler()
+    : startUniverse(0), numUniverses(0), numLeds(0), receivedCount(0),
+      generation(0), frameSequence(0), staleCount(0), pixelFrame(0), pixelsReceived(0), pixelsExpected(0),
+      pixelFrameDone(false), lastPixelSequence(0) {
+  memset(pixelOffset, 0, sizeof(pixelOffset));
+  memset(receivedMask, 0, sizeof(receivedMask));
+  memset(pixelMask, 0, sizeof(pixelMask));
+  memset(lastSequence, 0, sizeof(lastSequence));
+  memset(&stats, 0, sizeof(stats));
+}
+
+bool FrameAssembler::begin(uint16_t _startUniverse, uint16_t _numUniverses,
+                           uint16_t pixelsPerUniverse, uint16_t _numLeds) {
+  if (_numUniverses > FRAME_ASSEMBLER_MAX_UNIVERSES ||
+      _numLeds > FRAME_ASSEMBLER_MAX_PIXELS)
+    return false;
+
+  startUniverse = _startUniverse;
+  numUniverses = _numUniverses;
+  numLeds = _numLeds;
+
+  // pixelOffset[u + 1] borne la fin de l'univers u
+  for (uint16_t u = 0; u <= numUniverses; u++) {
+    uint32_t offset = (uint32_t)u * pixelsPerUniverse;
+    pixelOffset[u] = offset < numLeds ? offset : numLeds;
+  }
+
+  memset(lastSequence, 0, sizeof(lastSequence));
+  lastPixelSequence = 0;
+  staleCount = 0;
+  reset();
+  return true;
+}
+
+bool FrameAssembler::add(uint16_t universe, uint16_t length, uint8_t sequence,
+                         uint16_t &firstPixel, uint16_t &pixelCount) {
+  uint16_t index = universe - startUniverse;
+  if (index >= numUniverses)
+    return false;
+
+  if (!checkSequence(lastSequence[index], sequence))
+    return false;
+
+  // Le premier univers reçu donne la séquence de la trame : un univers d'une
+  // autre trame ne la complète jamais
+  if (sequence && frameSequence && receivedCount &&
+      sequence != frameSequence) {
+    int8_t delta = (int8_t)(sequence - frameSequence);
+    if (delta < 0 && delta > -SEQUENCE_STALE_WINDOW && rejectStale())
+      return false;
+    dropFrame();
+  }
+
+  uint32_t bit = 1UL << (index & 31);
+  if (receivedMask[index >> 5] & bit)
+    dropFrame();
+  if (!receivedCount)
+    frameSequence = sequence;
+  receivedMask[index >> 5] |= bit;
+  receivedCount++;
+  staleCount = 0;
+
+  firstPixel = pixelOffset[index];
+  uint16_t room = pixelOffset[index + 1] - firstPixel;
+  pixelCount = length / 3 < room ? length / 3 : room;
+  return true;
+}
+
+bool FrameAssembler::addPixels(uint16_t frame, uint16_t firstPixel,
+                               uint16_t length, uint8_t sequence, bool last,
+                               uint16_t &pixelCount) {
+  if (!checkSequence(lastPixelSequence, sequence))
+    return false;
+
+  // Un paquet d'une trame plus ancienne, ou de la trame qui vient d'être
+  // complétée, est écarté sans toucher à la trame en cours. Au-delà de la
+  // fenêtre, l'émetteur a redémarré.
+  if (pixelFrameDone || pixelsReceived || pixelsExpected) {
+    int16_t age = (int16_t)(frame - pixelFrame);
+    if (((age < 0 && age > -SEQUENCE_STALE_WINDOW) ||
+         (age == 0 && pixelFrameDone)) &&
+        rejectStale())
+      return false;
+  }
+  pixelFrameDone = false;
+
+  if ((pixelsReceived || pixelsExpected) && frame != pixelFrame) {
+    if (!isComplete()) {
+      uint16_t expected = pixelsExpected ? pixelsExpected : numLeds;
+      stats.framesDropped++;
+      if (expected > pixelsReceived)
+        stats.lostPixels += expected - pixelsReceived;
+    }
+    reset();
+  }
+  pixelFrame = frame;
+
+  uint16_t room = firstPixel < numLeds ? numLeds - firstPixel : 0;
+  pixelCount = length / 3 < room ? length / 3 : room;
+  // les pixels au-delà de numLeds ne sont pas attendus
+  uint16_t end = firstPixel < numLeds ? firstPixel + pixelCount : numLeds;
+  if (last) {
+    // les pixels reçus après la fin de la trame ne la complètent pas
+    pixelsReceived = end - coverPixels(0, end, false);
+    pixelsExpected = end;
+  }
+  uint16_t limit = pixelsExpected ? pixelsExpected : numLeds;
+  if (firstPixel < limit)
+    pixelsReceived += coverPixels(
+        firstPixel, (end < limit ? end : limit) - firstPixel, true);
+  staleCount = 0;
+  return true;
+}
+
+bool FrameAssembler::checkSequence(uint8_t &last, uint8_t sequence) {
+  if (sequence) {
+    int8_t delta = (int8_t)(sequence - last);
+    if (last && delta <= 0 && delta > -SEQUENCE_STALE_WINDOW &&
+        rejectStale())
+      return false;
+    if (last && delta > 1) {
+      // la séquence passe de 255 à 1, 0 signifie désactivée
+      uint8_t gap = sequence < last ? delta - 1 : delta;
+      stats.lostPackets += gap - 1;
+    }
+    last = sequence;
+  }
+  return true;
+}
+
+bool FrameAssembler::rejectStale() {
+  if (++staleCount < SEQUENCE_RESYNC_REJECTS) {
+    stats.reordered++;
+    return true;
+  }
+  // L'émetteur a redémarré avec des numéros plus petits
+  staleCount = 0;
+  memset(lastSequence, 0, sizeof(lastSequence));
+  lastPixelSequence = 0;
+  frameSequence = 0;
+  pixelFrameDone = false;
+  return false;
+}
+
+void FrameAssembler::dropFrame() {
+  if (!isComplete()) {
+    stats.framesDropped++;
+    stats.lostUniverses += numUniverses - receivedCount;
+  }
+  reset();
+}
+
+uint16_t FrameAssembler::coverPixels(uint16_t firstPixel,
+                                    uint16_t pixelCount, bool mark) {
+  uint16_t added = 0;
+  uint32_t pixel = firstPixel;
+  uint32_t end = pixel + pixelCount;
+  // un mot de 32 pixels à la fois
+  while (pixel < end) {
+    uint8_t shift = pixel & 31;
+    uint32_t n = end - pixel < 32u - shift ? end - pixel : 32u - shift;
+    uint32_t bits = (n == 32 ? 0xFFFFFFFFUL : (1UL << n) - 1) << shift;
+    uint32_t &word = pixelMask[pixel >> 5];
+    added += __builtin_popcount(bits & ~word);
+    if (mark)
+      word |= bits;
+    pixel += n;
+  }
+  return added;
+}
+
+uint16_t FrameAssembler::received() const {
+  uint16_t count = 0;
+  for (int i = 0; i < FRAME_ASSEMBLER_MASK_WORDS; i++)
+    count += __builtin_popcount(receivedMask[i]);
+  return count;
+}
+
+void FrameAssembler::reset() {
+  if (isComplete())
+    stats.frames++;
+  pixelFrameDone = pixelsExpected && pixelsReceived >= pixelsExpected;
+  memset(receivedMask, 0, sizeof(receivedMask));
+  receivedCount = 0;
+  // le masque des pixels ne sert qu'aux trames ART_PIXEL
+  if (pixelsReceived || pixelsExpected)
+    memset(pixelMask, 0, ((numLeds + 31) / 32) * sizeof(uint32_t));
+  pixelsReceived = 0;
+  pixelsExpected = 0;
+  generation++;
+}
+
+#endif // FRAMEASSEMBLER_H
@@ -1,8 +1,8 @@
 /**
  * @file LEDController.h
  * @brief Fichier d'en-tête pour la classe LEDController.
- * @details Une classe pour contrôler les bandes LED en utilisant OctoWS2811 et
- * FastLED.
+ * @details Une classe pour contrôler les bandes LED avec un pilote de sortie
+ * (OutputBackend) et FastLED.
  * @version V0.2.1
  * @date 2023
  *
@@ -23,34 +23,92 @@
  * <https://www.gnu.org/licenses/>.
  */
 
+#include "ColorKernel.h"
 #include "Debug.h"
+#include "FrameAssembler.h"
+#include "OutputBackend.h"
+#include "PacketRing.h"
+#include "PixelDecoder.h"
+#include "PowerBudget.h"
 #include <Artnet.h>
 
 /**
  * @class LEDController
- * @brief Une classe pour contrôler les bandes LED en utilisant OctoWS2811 et
- * FastLED.
+ * @brief Une classe pour contrôler les bandes LED avec un pilote de sortie
+ * (OutputBackend) et FastLED.
  */
 class LEDController : public CPixelLEDController<RGB, 8, 0xFF> {
-  OctoWS2811 *pocto;
+  OutputBackend *output;
   unsigned long lastFrameTime;
   int statusPin;
   bool isRGBW;
   int flip = 0;
   int numLeds;
   CRGB *rgbarray;
-  bool sendFrame;
-  int startUniverse;
-  int maxUniverses;
-  bool *universesReceived;
-  int previousDataLength;
+  FrameAssembler assembler;
+  PacketRing *packetRing;
+  bool framePending;
+  CRGB *backBuffer;
+  CLEDController *ledOutput;
+  bool artSyncEnabled;
+  bool syncMode;
+  unsigned long lastSyncTime;
+  unsigned long syncTimeout;
+  bool directOutput;
+  ColorKernel artnetKernel; // données Artnet -> tampon de dessin
+  ColorKernel ledKernel;    // tableau FastLED (déjà corrigé) -> tampon de dessin
+  PowerBudget power;
+  uint32_t powerGeneration; // trame dont les sommes sont dans power
+  uint32_t bytesWritten;    // octets écrits dans le tableau CRGB et la trame
+  PixelDecoder decoder;     // paquets ART_PIXEL_RLE
+
+  /**
+   * @brief Envoyer la trame assemblée vers les LEDs.
+   * @details En sortie directe, ne bloque pas : la trame reste en attente si
+   * la sortie DMA est occupée.
+   */
+  void showFrame();
+
+  /**
+   * @brief Convertir les pixels RGB d'un univers directement dans le tampon
+   * de dessin du pilote de sortie avec artnetKernel.
+   * @param data Données DMX de l'univers.
+   * @param firstPixel Index du premier pixel de l'univers.
+   * @param pixelCount Nombre de pixels de l'univers.
+   */
+  void scatter(const uint8_t *data, uint16_t firstPixel, uint16_t pixelCount);
+
+  /**
+   * @brief Écrire les pixels RGB acceptés par l'assemblage et valider la
+   * trame si elle est complète.
+   * @param data Données RGB.
+   * @param firstPixel Index du premier pixel.
+   * @param pixelCount Nombre de pixels.
+   */
+  void storePixels(const uint8_t *data, uint16_t firstPixel,
+                   uint16_t pixelCount);
+
+  /**
+   * @brief Valider la trame assemblée : échanger les tampons avant/arrière et
+   * marquer la trame en attente d'affichage.
+   */
+  void latchFrame();
+
+  /**
+   * @brief Convertir les pixels FastLED (déjà corrigés) dans le tampon de
+   * dessin avec ledKernel, limiter le courant comme en sortie directe et
+   * envoyer la trame.
+   * @details FastLED.show() bloque jusqu'au départ de la trame.
+   * @param pixels Pixels de FastLED.
+   */
+  void drawPixels(PixelController<RGB, 8, 0xFF> &pixels);
 
 public:
   /**
    * @brief Constructeur pour LEDController.
-   * @param _pocto Pointeur vers l'objet OctoWS2811.
+   * @param _output Pointeur vers le pilote de sortie.
    */
-  LEDController(OctoWS2811 *_pocto);
+  LEDController(OutputBackend *_output);
 
   /**
    * @brief Initialiser le motif de test LED.
@@ -79,6 +137,109 @@ public:
    */
   void setStatusPin(int pin);
 
+  /**
+   * @brief Définir le tableau de LEDs à remplir avec les données Artnet.
+   * @param _rgbarray Pointeur vers le tableau de LEDs FastLED.
+   * @param _numLeds Nombre de LEDs dans le tableau.
+   */
+  void setLeds(CRGB *_rgbarray, int _numLeds);
+
+  /**
+   * @brief Définir le tampon arrière dans lequel les univers sont assemblés.
+   * @details Le tableau de LEDs et le tampon arrière sont échangés à chaque
+   * trame validée, le contrôleur FastLED est redirigé vers le nouveau tampon
+   * avant. Sans tampon arrière, les univers sont écrits directement dans le
+   * tableau de LEDs.
+   * @param _backBuffer Tableau de même taille que le tableau de LEDs.
+   * @param _ledOutput Contrôleur FastLED qui affiche le tableau de LEDs.
+   */
+  void setBackBuffer(CRGB *_backBuffer, CLEDController *_ledOutput);
+
+  /**
+   * @brief Définir la trame de référence des paquets ART_PIXEL compressés.
+   * @details À appeler après setLeds(). Les sorties sont en double tampon
+   * et déjà converties : les trames delta sont appliquées à cette trame RGB,
+   * puis les pixels du paquet sont écrits comme un paquet non compressé.
+   * Sans trame de référence, les paquets compressés sont écartés.
+   * @param buffer Tableau de numLeds * 3 octets.
+   */
+  void setDecodeBuffer(uint8_t *buffer);
+
+  /**
+   * @brief Définir l'ordre des couleurs de la bande.
+   * @param config Ordre des couleurs de la trame (WS2811_GRBW...), voir
+   * OutputCapabilities::colorOrder.
+   */
+  void setColorOrder(uint8_t config);
+
+  /**
+   * @brief Écrire les univers reçus directement dans le tampon de dessin
+   * du pilote de sortie, sans passer par le tableau de LEDs et FastLED.
+   * @details La luminosité et la balance sont appliquées par setBrightness()
+   * et setColorBalance(), sans le dithering de FastLED. Si le pilote garde
+   * les trames (OutputCapabilities::frameQueue), l'assemblage de la trame
+   * suivante continue pendant l'envoi.
+   * @param enabled True pour la sortie directe.
+   */
+  void setDirectOutput(bool enabled);
+
+  /**
+   * @brief Définir la luminosité appliquée aux données Artnet en sortie
+   * directe.
+   * @param brightness Luminosité de 0 à 255.
+   */
+  void setBrightness(uint8_t brightness);
+
+  /**
+   * @brief Définir la balance des couleurs appliquée aux données Artnet en
+   * sortie directe.
+   * @param r Gain de la composante rouge de 0 à 255.
+   * @param g Gain de la composante verte de 0 à 255.
+   * @param b Gain de la composante bleue de 0 à 255.
+   */
+  void setColorBalance(uint8_t r, uint8_t g, uint8_t b);
+
+  /**
+   * @brief Appliquer les courbes gamma de gamma8.h (rg8, gg8, bg8) en sortie.
+   * @param enabled True pour appliquer les courbes.
+   */
+  void setGammaCurves(bool enabled);
+
+  /**
+   * @brief Activer la validation des trames par ArtSync.
+   * @details Dès qu'un ArtSync est reçu, une trame complète n'est affichée
+   * qu'à l'ArtSync suivant. Sans ArtSync pendant timeoutMs, on revient à
+   * l'affichage dès que tous les univers sont reçus.
+   * @param enabled True pour suivre les ArtSync, false pour les ignorer.
+   * @param timeoutMs Délai sans ArtSync avant de quitter le mode ArtSync.
+   */
+  void setArtSync(bool enabled, unsigned long timeoutMs);
+
+  /**
+   * @brief Définir les univers Artnet attendus pour une trame complète.
+   * @details À appeler après setLeds().
+   * @param startUniverse Numéro du premier univers.
+   * @param maxUniverses Nombre d'univers par trame.
+   * @param pixelsPerUniverse Nombre de pixels RGB dans un univers.
+   */
+  void setUniverses(int startUniverse, int maxUniverses,
+                    int pixelsPerUniverse);
+
+  /**
+   * @brief Définir le tampon de paquets rempli par le côté réseau.
+   * @param _packetRing Pointeur vers le tampon circulaire de paquets DMX.
+   */
+  void setPacketRing(PacketRing *_packetRing);
+
+  /**
+   * @brief Étage de rendu : vider le tampon de paquets, assembler les trames
+   * et les envoyer aux LEDs quand la sortie DMA est libre.
+   * @details Ne bloque jamais : si une trame est prête mais que la sortie
+   * précédente n'est pas terminée, elle reste en attente et les paquets
+   * suivants restent dans le tampon.
+   */
+  void render();
+
   /**
    * @brief Définir le type de bande LED (RGB ou RGBW).
    * @param rgbw True si la bande est RGBW, false si elle est RGB.
@@ -98,7 +259,9 @@ public:
   virtual void showPixels(PixelController<RGB, 8, 0xFF> &pixels);
 
   /**
-   * @brief Gérer les trames Artnet/DMX entrantes.
+   * @brief Assembler un paquet Artnet/DMX dans la trame en cours.
+   * @details Appelé par l'étage de rendu ; marque la trame en attente
+   * d'affichage lorsque tous les univers ont été reçus.
    * @param universe Numéro de l'univers.
    * @param length Longueur des données.
    * @param sequence Numéro de séquence.
@@ -107,6 +270,51 @@ public:
   void onDmxFrameFull(uint16_t universe, uint16_t length, uint8_t sequence,
                       uint8_t *data);
 
+  /**
+   * @brief Assembler un paquet de pixels ART_PIXEL dans la trame en cours.
+   * @details Comme onDmxFrameFull(), pour un paquet qui porte jusqu'à 484
+   * pixels placés par leur index dans la trame. Un paquet ART_PIXEL_RLE est
+   * d'abord décodé dans la trame de référence (voir setDecodeBuffer()).
+   * @param frame Numéro de trame.
+   * @param firstPixel Index du premier pixel du paquet.
+   * @param length Longueur des données RGB.
+   * @param sequence Numéro de séquence.
+   * @param flags ART_PIXEL_LAST pour le dernier paquet de la trame.
+   * @param data Pointeur vers le tableau de données.
+   */
+  void onPixels(uint16_t frame, uint16_t firstPixel, uint16_t length,
+                uint8_t sequence, uint8_t flags, uint8_t *data);
+
+  /**
+   * @brief Retourner les compteurs de l'assemblage des trames.
+   */
+  const FrameStats &getFrameStats() const { return assembler.getStats(); }
+
+  /**
+   * @brief Retourner la limitation du courant par groupe d'injection.
+   * @details Active en sortie directe dès que les groupes sont définis par
+   * PowerBudget::setGroups(). Le courant est estimé pendant la conversion des
+   * univers, la trame est limitée quand elle est validée.
+   */
+  PowerBudget &getPowerBudget() { return power; }
+
+  /**
+   * @brief Retourner le nombre d'octets écrits dans le tableau CRGB et dans
+   * le tampon de dessin depuis le démarrage (mesure des bancs).
+   */
+  uint32_t getBytesWritten() const { return bytesWritten; }
+
+  /**
+   * @brief Afficher les compteurs de l'assemblage des trames et le courant
+   * de chaque groupe d'injection.
+   */
+  void printStats();
+
+  /**
+   * @brief Gérer un ArtSync : valider la trame assemblée si elle est complète.
+   */
+  void onSync();
+
   /**
    * @brief Retourner l'état marche/arrêt basé sur la valeur de flip.
    * @return True si (flip / 15) % 2 == 0, false sinon.
@@ -115,44 +323,36 @@ public:
 
   /**
    * @class CTeensy4Controller
-   * @brief Une classe pour contrôler les bandes LED en utilisant OctoWS2811 et
-   * FastLED.
+   * @brief Une classe pour contrôler les bandes LED avec un pilote de sortie
+   * (OutputBackend) et FastLED.
    */
   class CTeensy4Controller : public CPixelLEDController<RGB, 8, 0xFF> {
-    OctoWS2811 *pocto;
+    OutputBackend *output;
     LEDController &ledController;
 
   public:
     /**
      * @brief Constructeur pour CTeensy4Controller.
-     * @param _pocto Pointeur vers l'objet OctoWS2811.
+     * @param _output Pointeur vers le pilote de sortie.
      * @param _ledController Référence à l'objet LEDController.
      */
-    CTeensy4Controller(OctoWS2811 *_pocto, LEDController &_ledController)
-        : pocto(_pocto), ledController(_ledController) {}
+    CTeensy4Controller(OutputBackend *_output, LEDController &_ledController)
+        : output(_output), ledController(_ledController) {}
 
     virtual void init() {}
     virtual void showPixels(PixelController<RGB, 8, 0xFF> &pixels) {
-      uint32_t i = 0;
-      while (pixels.has(1)) {
-        uint8_t r = pixels.loadAndScale0();
-        uint8_t g = pixels.loadAndScale1();
-        uint8_t b = pixels.loadAndScale2();
-        uint8_t w = ledController.whiteFromRGB(r, g, b);
-        pocto->setPixel(i++, r, g, b, w);
-
-        pixels.stepDithering();
-        pixels.advanceData();
-      }
-      pocto->show();
+      ledController.drawPixels(pixels);
     }
   };
 };
 
-LEDController::LEDController(OctoWS2811 *_pocto)
-    : pocto(_pocto), lastFrameTime(0), statusPin(-1), isRGBW(false), numLeds(0),
-      rgbarray(nullptr), sendFrame(false), startUniverse(0), maxUniverses(0),
-      universesReceived(nullptr), previousDataLength(0) {}
+LEDController::LEDController(OutputBackend *_output)
+    : output(_output), lastFrameTime(0), statusPin(-1), isRGBW(false), numLeds(0),
+      rgbarray(nullptr), packetRing(nullptr),
+      framePending(false), backBuffer(nullptr), ledOutput(nullptr),
+      artSyncEnabled(false), syncMode(false),
+      lastSyncTime(0), syncTimeout(4000), directOutput(false),
+      powerGeneration(0), bytesWritten(0) {}
 
 void LEDController::initTest() {
   const int delaytime = 200;
@@ -162,14 +362,14 @@ void LEDController::initTest() {
   FastLED.show();
   delay(delaytime);
 
-  Debug::println("\t DRAW LED RED");
+  DEBUG_INFO("\t DRAW LED RED\n");
 
   for (int i = 0; i < numLeds; i++)
     rgbarray[i] = CRGB::Green;
   FastLED.show();
   delay(delaytime);
 
-  Debug::println("\t DRAW LED GREEN");
+  DEBUG_INFO("\t DRAW LED GREEN\n");
 
   delay(delaytime);
   for (int i = 0; i < numLeds; i++)
@@ -177,7 +377,7 @@ void LEDController::initTest() {
   FastLED.show();
   delay(delaytime);
 
-  Debug::println("\t DRAW LED BLUE");
+  DEBUG_INFO("\t DRAW LED BLUE\n");
 
   delay(delaytime);
   for (int i = 0; i < numLeds; i++)
@@ -185,7 +385,7 @@ void LEDController::initTest() {
   FastLED.show();
   delay(delaytime);
 
-  Debug::println("\t DRAW LED WHITE");
+  DEBUG_INFO("\t DRAW LED WHITE\n");
 
   delay(delaytime);
   for (int i = 0; i < numLeds; i++)
@@ -193,7 +393,7 @@ void LEDController::initTest() {
   FastLED.show();
   delay(delaytime);
 
-  Debug::println("\t DRAW LED BLACK");
+  DEBUG_INFO("\t DRAW LED BLACK\n");
 }
 
 void LEDController::setRGB(int r, int g, int b) {
@@ -220,7 +420,64 @@ void LEDController::setStatusPin(int pin) {
   pinMode(statusPin, OUTPUT);
 }
 
-void LEDController::setStripType(bool rgbw) { isRGBW = rgbw; }
+void LEDController::setLeds(CRGB *_rgbarray, int _numLeds) {
+  rgbarray = _rgbarray;
+  numLeds = _numLeds;
+}
+
+void LEDController::setBackBuffer(CRGB *_backBuffer,
+                                  CLEDController *_ledOutput) {
+  backBuffer = _backBuffer;
+  ledOutput = _ledOutput;
+}
+
+void LEDController::setDecodeBuffer(uint8_t *buffer) {
+  decoder.begin(buffer, numLeds);
+}
+
+void LEDController::setColorOrder(uint8_t config) {
+  artnetKernel.setOrder(config);
+  ledKernel.setOrder(config);
+}
+
+void LEDController::setDirectOutput(bool enabled) { directOutput = enabled; }
+
+void LEDController::setBrightness(uint8_t brightness) {
+  artnetKernel.setBrightness(brightness);
+}
+
+void LEDController::setColorBalance(uint8_t r, uint8_t g, uint8_t b) {
+  artnetKernel.setBalance(r, g, b);
+}
+
+void LEDController::setGammaCurves(bool enabled) {
+  artnetKernel.setCurves(enabled);
+  ledKernel.setCurves(enabled);
+}
+
+void LEDController::setArtSync(bool enabled, unsigned long timeoutMs) {
+  artSyncEnabled = enabled;
+  syncTimeout = timeoutMs;
+  if (!enabled)
+    syncMode = false;
+}
+
+void LEDController::setUniverses(int startUniverse, int maxUniverses,
+                                 int pixelsPerUniverse) {
+  if (!assembler.begin(startUniverse, maxUniverses, pixelsPerUniverse,
+                       numLeds))
+    DEBUG_ERROR("ERROR: too many universes or LEDs\n");
+}
+
+void LEDController::setPacketRing(PacketRing *_packetRing) {
+  packetRing = _packetRing;
+}
+
+void LEDController::setStripType(bool rgbw) {
+  isRGBW = rgbw;
+  artnetKernel.setRGBW(rgbw);
+  ledKernel.setRGBW(rgbw);
+}
 
 uint8_t LEDController::whiteFromRGB(uint8_t &r, uint8_t &g, uint8_t &b) {
   if (isRGBW) {
@@ -234,58 +491,253 @@ uint8_t LEDController::whiteFromRGB(uint8_t &r, uint8_t &g, uint8_t &b) {
 }
 
 void LEDController::showPixels(PixelController<RGB, 8, 0xFF> &pixels) {
-  uint32_t i = 0;
+  drawPixels(pixels);
+}
+
+void LEDController::drawPixels(PixelController<RGB, 8, 0xFF> &pixels) {
+  const uint8_t step = ledKernel.getBytesPerPixel();
+  uint8_t *frame = output->getDrawBuffer();
+  uint8_t *dest = frame;
+  bool limited = power.isEnabled();
+  if (limited)
+    power.reset();
+  uint32_t *sums = nullptr;
+  uint16_t segmentLeft = 0; // pixels restants avant la limite du groupe
+  uint16_t pixel = 0;
   while (pixels.has(1)) {
-    uint8_t r = pixels.loadAndScale0();
-    uint8_t g = pixels.loadAndScale1();
-    uint8_t b = pixels.loadAndScale2();
-    uint8_t w = whiteFromRGB(r, g, b);
-    pocto->setPixel(i++, r, g, b, w);
+    const uint8_t rgb[3] = {pixels.loadAndScale0(), pixels.loadAndScale1(),
+                            pixels.loadAndScale2()};
+    if (limited && !segmentLeft) {
+      segmentLeft = numLeds - pixel;
+      sums = power.sumsAt(pixel, segmentLeft);
+    }
+    ledKernel.apply(rgb, dest, 1, sums);
+    dest += step;
+    pixel++;
+    if (limited)
+      segmentLeft--;
 
     pixels.stepDithering();
     pixels.advanceData();
   }
-  pocto->show();
+  bytesWritten += pixel * step;
+  // Même limite de courant que les trames Artnet (initTest() en blanc)
+  if (limited)
+    power.limit(frame, step);
+  output->prepare(frame);
+  while (!output->startOutput()) {
+  }
 }
 
 void LEDController::onDmxFrameFull(uint16_t universe, uint16_t length,
                                    uint8_t sequence, uint8_t *data) {
-  sendFrame = 1;
   lastFrameTime = millis();
 
-  if ((universe - startUniverse) < maxUniverses)
-    universesReceived[universe - startUniverse] = 1;
+  uint16_t firstPixel, pixelCount;
+  if (!assembler.add(universe, length, sequence, firstPixel, pixelCount))
+    return;
 
-  for (int i = 0; i < maxUniverses; i++) {
-    if (universesReceived[i] == 0) {
-      sendFrame = 0;
-      break;
+  DEBUG_TRACE(DEBUG_EVENT_UNIVERSE, universe, length, assembler.received());
+  storePixels(data, firstPixel, pixelCount);
+}
+
+void LEDController::onPixels(uint16_t frame, uint16_t firstPixel,
+                             uint16_t length, uint8_t sequence, uint8_t flags,
+                             uint8_t *data) {
+  lastFrameTime = millis();
+
+  // Paquet compressé : vérifié avant que l'assemblage compte ses pixels,
+  // une trame n'est jamais complète avec une plage non décodée
+  bool coded = flags & ART_PIXEL_RLE;
+  uint16_t pixelLength = length;
+  if (coded) {
+    uint16_t count = PixelDecoder::pixelCount(data, length);
+    if (!decoder.canDecode(frame, flags) || count > numLeds) {
+      decoder.drop();
+      return;
     }
+    if (!decoder.check(data, length, flags))
+      return;
+    pixelLength = count * 3;
   }
 
-  if (Debug::DEBUG) {
-    Debug::printf("universe number = %d\tdata length = %d\tDMX data[0]: "
-                  "%d\tsendFrame = %d\n",
-                  artnet.getUniverse(), artnet.getLength(), data[0], sendFrame);
+  uint16_t pixelCount;
+  if (!assembler.addPixels(frame, firstPixel, pixelLength, sequence,
+                           flags & ART_PIXEL_LAST, pixelCount))
+    return;
+
+  if (coded) {
+    bool complete = assembler.isComplete();
+    decoder.decode(data, length, flags, firstPixel);
+    data = (uint8_t *)decoder.pixels(firstPixel);
+    if (complete)
+      decoder.setReference(frame);
   }
 
-  for (int i = 0; i < length / 3; i++) {
-    int led = i + (universe - startUniverse) * (previousDataLength / 3);
-    if (led < numLeds) {
-      rgbarray[led] = CRGB(data[i * 3], data[i * 3 + 1], data[i * 3 + 2]);
+  DEBUG_TRACE(DEBUG_EVENT_PIXELS, frame, firstPixel, pixelCount);
+  storePixels(data, firstPixel, pixelCount);
+}
+
+void LEDController::storePixels(const uint8_t *data, uint16_t firstPixel,
+                                uint16_t pixelCount) {
+  if (directOutput) {
+    scatter(data, firstPixel, pixelCount);
+  } else {
+    CRGB *leds = (backBuffer ? backBuffer : rgbarray) + firstPixel;
+    for (int i = 0; i < pixelCount; i++) {
+      leds[i] = CRGB(data[i * 3], data[i * 3 + 1], data[i * 3 + 2]);
     }
+    bytesWritten += pixelCount * sizeof(CRGB);
+  }
+
+  if (assembler.isComplete()) {
+    // En mode ArtSync, la trame attend l'ArtSync pour être affichée
+    if (!syncMode)
+      latchFrame();
+  }
+}
+
+void LEDController::scatter(const uint8_t *data, uint16_t firstPixel,
+                            uint16_t pixelCount) {
+  const uint8_t step = artnetKernel.getBytesPerPixel();
+  uint8_t *dest = output->getDrawBuffer() + firstPixel * step;
+  bytesWritten += pixelCount * step;
+  if (!power.isEnabled()) {
+    artnetKernel.apply(data, dest, pixelCount);
+    return;
+  }
+
+  // Une nouvelle trame a commencé (trame validée ou abandonnée)
+  if (assembler.getGeneration() != powerGeneration) {
+    power.reset();
+    powerGeneration = assembler.getGeneration();
+  }
+  // L'univers est découpé aux limites des groupes d'injection
+  while (pixelCount) {
+    uint16_t count = pixelCount;
+    uint32_t *sums = power.sumsAt(firstPixel, count);
+    artnetKernel.apply(data, dest, count, sums);
+    data += count * 3;
+    dest += count * step;
+    firstPixel += count;
+    pixelCount -= count;
+  }
+}
+
+void LEDController::onSync() {
+  if (!artSyncEnabled)
+    return;
+
+  if (!syncMode)
+    DEBUG_TRACE(DEBUG_EVENT_SYNC_MODE, 0, 0, 0);
+  syncMode = true;
+  lastSyncTime = millis();
+
+  if (assembler.isComplete())
+    latchFrame();
+}
+
+void LEDController::latchFrame() {
+  if (backBuffer && !directOutput) {
+    CRGB *front = backBuffer;
+    backBuffer = rgbarray;
+    rgbarray = front;
+    if (ledOutput)
+      ledOutput->setLeds(rgbarray, numLeds);
+  }
+  if (directOutput) {
+    uint8_t *frame = output->getDrawBuffer();
+    if (power.isEnabled())
+      power.limit(frame, artnetKernel.getBytesPerPixel());
+    // Si le pilote garde la trame, une trame précédente pas encore envoyée
+    // est remplacée par la plus récente
+    output->prepare(frame);
   }
+  framePending = true;
 
-  previousDataLength = length;
+  assembler.reset();
+}
 
-  if (sendFrame) {
-    if (Debug::DEBUG)
-      Debug::println("\t DRAW LEDs");
+void LEDController::showFrame() {
+  // En sortie directe, le tampon de dessin est déjà rempli : la sortie démarre
+  // sans attendre et la trame suivante s'assemble pendant l'envoi
+  if (directOutput) {
+    if (!output->startOutput())
+      return; // trame précédente encore en cours d'envoi, on réessaiera
+  } else {
     FastLED.show();
-    flip += 1;
+  }
+  DEBUG_TRACE(DEBUG_EVENT_FRAME, flip, 0, 0);
+  flip += 1;
+  framePending = false;
+}
+
+void LEDController::render() {
+  if (!packetRing)
+    return;
+
+  // Plus d'ArtSync depuis syncTimeout : retour à l'affichage dès que tous les
+  // univers sont reçus
+  if (syncMode && millis() - lastSyncTime > syncTimeout) {
+    syncMode = false;
+    DEBUG_TRACE(DEBUG_EVENT_SYNC_TIMEOUT, 0, 0, 0);
+    if (assembler.isComplete())
+      latchFrame();
+  }
+
+  if (framePending && !output->isBusy())
+    showFrame();
+
+  // Sans tampon arrière (ou en sortie directe si le pilote ne garde pas la
+  // trame), une trame en attente de la sortie DMA bloque l'assemblage : les
+  // paquets s'accumulent dans le tampon circulaire.
+  bool canAssemble =
+      directOutput ? output->capabilities().frameQueue : backBuffer != nullptr;
+  DmxPacket *packet;
+  while ((!framePending || canAssemble) &&
+         (packet = packetRing->front()) != nullptr) {
+    if (packet->opcode == ART_SYNC)
+      onSync();
+    else if (packet->opcode == ART_PIXEL)
+      onPixels(packet->universe, packet->firstPixel, packet->length,
+               packet->sequence, packet->flags, packet->data());
+    else
+      onDmxFrameFull(packet->universe, packet->length, packet->sequence,
+                     packet->data());
+    packetRing->pop();
+  }
+
+  if (framePending && !output->isBusy())
+    showFrame();
+}
 
-    memset(universesReceived, 0, maxUniverses);
-    previousDataLength = 0;
+void LEDController::printStats() {
+  const FrameStats &stats = assembler.getStats();
+  DEBUG_INFO("output = %s\tframes = %lu\tdropped = %lu\t"
+                "lost universes = %lu\tlost pixels = %lu\treordered = %lu\t"
+                "lost packets = %lu\tring overflows = %lu\n",
+                output->capabilities().name, (unsigned long)stats.frames,
+                (unsigned long)stats.framesDropped,
+                (unsigned long)stats.lostUniverses,
+                (unsigned long)stats.lostPixels,
+                (unsigned long)stats.reordered,
+                (unsigned long)stats.lostPackets,
+                packetRing ? (unsigned long)packetRing->getOverflows() : 0UL);
+  if (decoder.isEnabled()) {
+    const PixelDecoderStats &ds = decoder.getStats();
+    DEBUG_INFO("decoded packets = %lu\tdelta dropped = %lu\t"
+               "decode errors = %lu\n",
+               (unsigned long)ds.packets, (unsigned long)ds.dropped,
+               (unsigned long)ds.errors);
+  }
+  for (uint8_t g = 0; g < power.getNumGroups(); g++) {
+    const PowerGroupStats &ps = power.getStats(g);
+    DEBUG_INFO("power group %u = %lu mA / %lu mA\theadroom = %ld mA\t"
+                  "scale = %lu%%\tlimited frames = %lu\n",
+                  g, (unsigned long)ps.current, (unsigned long)ps.budget,
+                  (long)ps.headroom,
+                  (unsigned long)(ps.scale * 100 / POWER_SCALE_ONE),
+                  (unsigned long)ps.limitedFrames);
   }
 }
 
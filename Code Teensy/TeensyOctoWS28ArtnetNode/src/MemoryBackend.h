@@ -0,0 +1,97 @@
+/**
+ * @file MemoryBackend.h
+ * @brief Fichier d'en-tête pour la classe MemoryBackend.
+ * @details Sortie en mémoire pour la compilation sur PC (environnement
+ * native) : les trames envoyées sont copiées dans un tampon et comptées, la
+ * sortie reste occupée le temps qu'un vrai envoi WS2811 prendrait.
+ * @version V0.2.1
+ * @date 2026
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ * Ce programme est un logiciel libre : vous pouvez le redistribuer et/ou le
+ * modifier selon les termes de la Licence Publique Générale GNU publiée par la
+ * Free Software Foundation, soit la version 3 de la licence, soit (à votre
+ * choix) toute version ultérieure.
+ *
+ * Ce programme est distribué dans l'espoir qu'il sera utile,
+ * mais SANS AUCUNE GARANTIE ; sans même la garantie implicite de
+ * QUALITÉ MARCHANDE ou d'ADÉQUATION À UN USAGE PARTICULIER. Voir la
+ * Licence Publique Générale GNU pour plus de détails.
+ *
+ * Vous devriez avoir reçu une copie de la Licence Publique Générale GNU
+ * avec ce programme. Si ce n'est pas le cas, voir
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MEMORYBACKEND_H
+#define MEMORYBACKEND_H
+
+#include "OutputBackend.h"
+
+/**
+ * @class MemoryBackend
+ * @brief Interface OutputBackend qui envoie les trames en mémoire.
+ */
+class MemoryBackend : public OutputBackend {
+  uint8_t *drawBuffer;
+  uint8_t *queueBuffer; // trame préparée, en attente de l'envoi
+  uint8_t *ledBuffer;   // dernière trame envoyée, ce que les LEDs affichent
+  size_t frameBytes;
+  uint32_t outputMicros;
+  uint32_t startMicros;
+  uint32_t framesSent;
+  OutputCapabilities caps;
+
+public:
+  /**
+   * @brief Constructeur pour MemoryBackend.
+   * @param _drawBuffer Tampon de dessin.
+   * @param _queueBuffer Tampon de la trame préparée.
+   * @param _ledBuffer Tampon de la trame envoyée.
+   * @param _frameBytes Taille d'une trame en octets (des trois tampons).
+   * @param config Ordre des couleurs de la bande (WS2811_GRBW...).
+   * @param _outputMicros Durée d'un envoi, en µs.
+   */
+  MemoryBackend(void *_drawBuffer, void *_queueBuffer, void *_ledBuffer,
+                size_t _frameBytes, uint8_t config, uint32_t _outputMicros)
+      : drawBuffer((uint8_t *)_drawBuffer),
+        queueBuffer((uint8_t *)_queueBuffer),
+        ledBuffer((uint8_t *)_ledBuffer), frameBytes(_frameBytes),
+        outputMicros(_outputMicros), startMicros(0), framesSent(0),
+        caps{"memory", 255, (uint8_t)(config & 0x1F), true, true} {}
+
+  const OutputCapabilities &capabilities() const override { return caps; }
+
+  uint8_t *getDrawBuffer() override { return drawBuffer; }
+
+  void prepare(uint8_t *frame) override {
+    memcpy(queueBuffer, frame, frameBytes);
+  }
+
+  bool startOutput() override {
+    if (isBusy())
+      return false;
+    memcpy(ledBuffer, queueBuffer, frameBytes);
+    startMicros = micros();
+    framesSent++;
+    return true;
+  }
+
+  bool isBusy() override {
+    return framesSent && micros() - startMicros < outputMicros;
+  }
+
+  /**
+   * @brief Retourner la dernière trame envoyée.
+   */
+  const uint8_t *getLedBuffer() const { return ledBuffer; }
+
+  /**
+   * @brief Retourner le nombre de trames envoyées.
+   */
+  uint32_t getFramesSent() const { return framesSent; }
+};
+
+#endif // MEMORYBACKEND_H
@@ -0,0 +1,71 @@
+/**
+ * @file ObjectFLEDBackend.h
+ * @brief Fichier d'en-tête pour la classe ObjectFLEDBackend.
+ * @details Sortie par ObjectFLED (https://github.com/KurtMF/ObjectFLED), le
+ * pilote du noeud Teensy_FLED_ArtnetNode. La trame est le tableau RGB donné à
+ * ObjectFLED, qui applique lui-même l'ordre des couleurs de la bande.
+ * @version V0.2.1
+ * @date 2026
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ * Ce programme est un logiciel libre : vous pouvez le redistribuer et/ou le
+ * modifier selon les termes de la Licence Publique Générale GNU publiée par la
+ * Free Software Foundation, soit la version 3 de la licence, soit (à votre
+ * choix) toute version ultérieure.
+ *
+ * Ce programme est distribué dans l'espoir qu'il sera utile,
+ * mais SANS AUCUNE GARANTIE ; sans même la garantie implicite de
+ * QUALITÉ MARCHANDE ou d'ADÉQUATION À UN USAGE PARTICULIER. Voir la
+ * Licence Publique Générale GNU pour plus de détails.
+ *
+ * Vous devriez avoir reçu une copie de la Licence Publique Générale GNU
+ * avec ce programme. Si ce n'est pas le cas, voir
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OBJECTFLEDBACKEND_H
+#define OBJECTFLEDBACKEND_H
+
+#include "OutputBackend.h"
+#include <OctoWS2811.h>
+#include <ObjectFLED.h> // doit être inclus avant FastLED.h
+
+/**
+ * @class ObjectFLEDBackend
+ * @brief Interface OutputBackend pour ObjectFLED.
+ */
+class ObjectFLEDBackend : public OutputBackend {
+  ObjectFLED *pfled;
+  uint8_t *drawBuffer;
+  OutputCapabilities caps;
+
+public:
+  /**
+   * @brief Constructeur pour ObjectFLEDBackend.
+   * @param _pfled Pointeur vers l'objet ObjectFLED, begin() déjà appelé.
+   * @param _drawBuffer Tableau RGB donné au constructeur d'ObjectFLED.
+   */
+  ObjectFLEDBackend(ObjectFLED *_pfled, void *_drawBuffer)
+      : pfled(_pfled), drawBuffer((uint8_t *)_drawBuffer),
+        caps{"ObjectFLED", NUM_DIGITAL_PINS, WS2811_RGB, false, false} {}
+
+  const OutputCapabilities &capabilities() const override { return caps; }
+
+  uint8_t *getDrawBuffer() override { return drawBuffer; }
+
+  // ObjectFLED convertit le tableau au moment de show()
+  void prepare(uint8_t *frame) override {}
+
+  bool startOutput() override {
+    if (pfled->busy())
+      return false;
+    pfled->show();
+    return true;
+  }
+
+  bool isBusy() override { return pfled->busy(); }
+};
+
+#endif // OBJECTFLEDBACKEND_H
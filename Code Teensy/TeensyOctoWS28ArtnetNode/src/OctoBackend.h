@@ -0,0 +1,71 @@
+/**
+ * @file OctoBackend.h
+ * @brief Fichier d'en-tête pour la classe OctoBackend.
+ * @details Sortie par OctoWS2811 : la trame est dessinée directement dans le
+ * tampon de dessin de la bibliothèque, sur n'importe quelles broches.
+ * @version V0.2.1
+ * @date 2026
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ * Ce programme est un logiciel libre : vous pouvez le redistribuer et/ou le
+ * modifier selon les termes de la Licence Publique Générale GNU publiée par la
+ * Free Software Foundation, soit la version 3 de la licence, soit (à votre
+ * choix) toute version ultérieure.
+ *
+ * Ce programme est distribué dans l'espoir qu'il sera utile,
+ * mais SANS AUCUNE GARANTIE ; sans même la garantie implicite de
+ * QUALITÉ MARCHANDE ou d'ADÉQUATION À UN USAGE PARTICULIER. Voir la
+ * Licence Publique Générale GNU pour plus de détails.
+ *
+ * Vous devriez avoir reçu une copie de la Licence Publique Générale GNU
+ * avec ce programme. Si ce n'est pas le cas, voir
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OCTOBACKEND_H
+#define OCTOBACKEND_H
+
+#include "OutputBackend.h"
+#include <OctoWS2811.h>
+
+/**
+ * @class OctoBackend
+ * @brief Interface OutputBackend pour OctoWS2811.
+ */
+class OctoBackend : public OutputBackend {
+  OctoWS2811 *pocto;
+  OutputCapabilities caps;
+
+public:
+  /**
+   * @brief Constructeur pour OctoBackend.
+   * @param _pocto Pointeur vers l'objet OctoWS2811, begin() déjà appelé.
+   * @param config Configuration passée à OctoWS2811 (WS2811_GRBW...).
+   * @param queue True si un troisième tampon a été donné à
+   * OctoWS2811::setBuffers() : prepare() appelle alors present().
+   */
+  OctoBackend(OctoWS2811 *_pocto, uint8_t config, bool queue)
+      : pocto(_pocto),
+        caps{"OctoWS2811", NUM_DIGITAL_PINS, (uint8_t)(config & 0x1F), true,
+             queue} {}
+
+  const OutputCapabilities &capabilities() const override { return caps; }
+
+  uint8_t *getDrawBuffer() override {
+    return (uint8_t *)pocto->getDrawBuffer();
+  }
+
+  void prepare(uint8_t *frame) override {
+    // Sans troisième tampon, la trame reste dans le tampon de dessin
+    if (caps.frameQueue)
+      pocto->present();
+  }
+
+  bool startOutput() override { return pocto->showAsync() != 0; }
+
+  bool isBusy() override { return pocto->busy(); }
+};
+
+#endif // OCTOBACKEND_H
@@ -0,0 +1,103 @@
+/**
+ * @file OutputBackend.h
+ * @brief Fichier d'en-tête pour l'interface OutputBackend.
+ * @details Interface commune aux pilotes de sortie LED (OctoWS2811, ObjectFLED,
+ * TriantaduoWS2811). LEDController ne connaît que cette interface : le pilote
+ * est choisi à la compilation par LED_BACKEND (un environnement PlatformIO par
+ * pilote), ce qui permet de comparer les pilotes sur le même rideau.
+ * @version V0.2.1
+ * @date 2026
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ * Ce programme est un logiciel libre : vous pouvez le redistribuer et/ou le
+ * modifier selon les termes de la Licence Publique Générale GNU publiée par la
+ * Free Software Foundation, soit la version 3 de la licence, soit (à votre
+ * choix) toute version ultérieure.
+ *
+ * Ce programme est distribué dans l'espoir qu'il sera utile,
+ * mais SANS AUCUNE GARANTIE ; sans même la garantie implicite de
+ * QUALITÉ MARCHANDE ou d'ADÉQUATION À UN USAGE PARTICULIER. Voir la
+ * Licence Publique Générale GNU pour plus de détails.
+ *
+ * Vous devriez avoir reçu une copie de la Licence Publique Générale GNU
+ * avec ce programme. Si ce n'est pas le cas, voir
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef OUTPUTBACKEND_H
+#define OUTPUTBACKEND_H
+
+#include <Arduino.h>
+
+// Pilotes de sortie disponibles pour LED_BACKEND
+#define LED_BACKEND_OCTOWS2811 0
+#define LED_BACKEND_OBJECTFLED 1
+#define LED_BACKEND_TDWS2811 2
+#define LED_BACKEND_MEMORY 3 // compilation sur PC, environnement native
+
+#ifndef LED_BACKEND
+#define LED_BACKEND LED_BACKEND_OCTOWS2811
+#endif
+
+/**
+ * @struct OutputCapabilities
+ * @brief Ce que le pilote sait faire, et le format de trame qu'il attend.
+ */
+struct OutputCapabilities {
+  const char *name;   // nom du pilote, pour les traces
+  uint8_t maxStrips;  // nombre maximum de bandes envoyées en parallèle
+  uint8_t colorOrder; // ordre des octets d'un pixel dans la trame (WS2811_*)
+  bool raggedStrips;  // les bandes peuvent avoir des longueurs différentes
+  bool frameQueue;    // prepare() garde la trame : la suivante peut être
+                      // dessinée pendant l'envoi
+};
+
+/**
+ * @class OutputBackend
+ * @brief Interface d'un pilote de sortie LED.
+ * @details La trame est écrite dans getDrawBuffer() : les bandes les unes
+ * après les autres, chaque pixel dans l'ordre capabilities().colorOrder. Une
+ * trame complète est confiée au pilote par prepare(), puis envoyée par
+ * startOutput() dès que isBusy() est faux. Le pilote lui-même (broches,
+ * tampons, timings) est configuré avant de créer l'interface.
+ */
+class OutputBackend {
+public:
+  virtual ~OutputBackend() {}
+
+  /**
+   * @brief Retourner les capacités du pilote.
+   */
+  virtual const OutputCapabilities &capabilities() const = 0;
+
+  /**
+   * @brief Retourner le tampon dans lequel dessiner la trame.
+   * @details Peut changer après prepare() ou startOutput() : à redemander
+   * pour chaque trame.
+   */
+  virtual uint8_t *getDrawBuffer() = 0;
+
+  /**
+   * @brief Confier une trame complète au pilote.
+   * @details Convertit la trame au format du pilote si besoin. Si
+   * capabilities().frameQueue est vrai, la trame est gardée par le pilote et
+   * une trame précédente pas encore envoyée est remplacée.
+   * @param frame Trame dessinée dans getDrawBuffer().
+   */
+  virtual void prepare(uint8_t *frame) = 0;
+
+  /**
+   * @brief Démarrer l'envoi de la trame préparée, sans attendre la fin.
+   * @return False si la trame précédente est encore en cours d'envoi : rien
+   * n'est démarré, il faudra réessayer.
+   */
+  virtual bool startOutput() = 0;
+
+  /**
+   * @brief Retourner true tant que la sortie précédente n'est pas terminée.
+   */
+  virtual bool isBusy() = 0;
+};
+
+#endif // OUTPUTBACKEND_H
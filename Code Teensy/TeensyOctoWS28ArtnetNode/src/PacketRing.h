@@ -0,0 +1,242 @@
+/**
+ * @file PacketRing.h
+ * @brief Fichier d'en-tête pour la classe PacketRing.
+ * @details Un tampon circulaire de taille fixe, sans allocation dynamique,
+ * pour les paquets DMX reçus par Artnet. Le côté réseau (producteur) remplit
+ * le tampon, l'étage de rendu (consommateur) le vide. Artnet peut recevoir
+ * directement dans la case libre suivante (voir reserve()) pour éviter une
+ * copie.
+ * @version V0.2.1
+ * @date 2026
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ * Ce programme est un logiciel libre : vous pouvez le redistribuer et/ou le
+ * modifier selon les termes de la Licence Publique Générale GNU publiée par la
+ * Free Software Foundation, soit la version 3 de la licence, soit (à votre
+ * choix) toute version ultérieure.
+ *
+ * Ce programme est distribué dans l'espoir qu'il sera utile,
+ * mais SANS AUCUNE GARANTIE ; sans même la garantie implicite de
+ * QUALITÉ MARCHANDE ou d'ADÉQUATION À UN USAGE PARTICULIER. Voir la
+ * Licence Publique Générale GNU pour plus de détails.
+ *
+ * Vous devriez avoir reçu une copie de la Licence Publique Générale GNU
+ * avec ce programme. Si ce n'est pas le cas, voir
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PACKETRING_H
+#define PACKETRING_H
+
+#include <Arduino.h>
+#include <Artnet.h>
+
+// Nombre de paquets en attente (puissance de 2). Doit couvrir au moins une
+// trame complète (23 à 30 univers selon l'étendard).
+#ifndef PACKET_RING_SIZE
+#define PACKET_RING_SIZE 32
+#endif
+
+// Nombre maximum de canaux dans un univers DMX
+#define DMX_MAX_CHANNELS 512
+
+/**
+ * @struct DmxPacket
+ * @brief Un paquet DMX reçu, tel que reçu par Artnet.
+ * @details Un ArtSync est mis dans le tampon comme un paquet sans données
+ * (opcode ART_SYNC) pour rester ordonné par rapport aux paquets ART_DMX.
+ * Pour un paquet de pixels (ART_PIXEL), universe est le numéro de trame.
+ */
+struct DmxPacket {
+  uint16_t opcode;
+  uint16_t universe;
+  uint16_t length;
+  uint8_t sequence;
+  uint8_t flags;       // ART_PIXEL : ART_PIXEL_LAST
+  uint16_t firstPixel; // ART_PIXEL : index du premier pixel
+  uint8_t raw[MAX_BUFFER_ARTNET]; // paquet Artnet complet, en-tête compris
+
+  /**
+   * @brief Retourner un pointeur vers les données DMX du paquet.
+   */
+  uint8_t *data() { return raw + ART_DMX_START; }
+};
+
+/**
+ * @class PacketRing
+ * @brief Tampon circulaire producteur/consommateur de paquets DMX.
+ */
+class PacketRing {
+  static_assert((PACKET_RING_SIZE & (PACKET_RING_SIZE - 1)) == 0,
+                "PACKET_RING_SIZE doit être une puissance de 2");
+
+  DmxPacket slots[PACKET_RING_SIZE];
+  volatile uint16_t head; // écrit uniquement par le producteur
+  volatile uint16_t tail; // écrit uniquement par le consommateur
+  uint32_t overflows;
+  uint32_t copiedBytes; // données copiées par push() et pushPixels()
+
+public:
+  /**
+   * @brief Constructeur pour PacketRing.
+   */
+  PacketRing() : head(0), tail(0), overflows(0), copiedBytes(0) {}
+
+  /**
+   * @brief Retourner le tampon de réception de la case libre suivante.
+   * @details À passer à Artnet::setPacketBuffer() : un paquet reçu dans ce
+   * tampon est ensuite ajouté par push() sans être copié.
+   * @return Tampon de MAX_BUFFER_ARTNET octets, ou nullptr si le tampon
+   * circulaire est plein.
+   */
+  uint8_t *reserve();
+
+  /**
+   * @brief Ajouter un paquet DMX au tampon (côté réseau).
+   * @details Les données ne sont copiées que si elles n'ont pas été reçues
+   * dans la case donnée par reserve().
+   * @param universe Numéro de l'univers.
+   * @param length Longueur des données.
+   * @param sequence Numéro de séquence.
+   * @param data Pointeur vers le tableau de données.
+   * @return False si le tampon est plein et que le paquet a été perdu.
+   */
+  bool push(uint16_t universe, uint16_t length, uint8_t sequence,
+            const uint8_t *data);
+
+  /**
+   * @brief Ajouter un paquet de pixels ART_PIXEL au tampon (côté réseau).
+   * @param frame Numéro de trame.
+   * @param firstPixel Index du premier pixel du paquet dans la trame.
+   * @param length Longueur des données RGB.
+   * @param sequence Numéro de séquence.
+   * @param flags ART_PIXEL_LAST pour le dernier paquet de la trame.
+   * @param data Pointeur vers le tableau de données.
+   * @return False si le tampon est plein et que le paquet a été perdu.
+   */
+  bool pushPixels(uint16_t frame, uint16_t firstPixel, uint16_t length,
+                  uint8_t sequence, uint8_t flags, const uint8_t *data);
+
+  /**
+   * @brief Ajouter un ArtSync au tampon (côté réseau).
+   * @return False si le tampon est plein et que l'ArtSync a été perdu.
+   */
+  bool pushSync();
+
+  /**
+   * @brief Retourner le plus ancien paquet sans le retirer (côté rendu).
+   * @return Pointeur vers le paquet, ou nullptr si le tampon est vide.
+   */
+  DmxPacket *front();
+
+  /**
+   * @brief Retirer le plus ancien paquet une fois traité (côté rendu).
+   */
+  void pop();
+
+  /**
+   * @brief Retourner le nombre de paquets en attente.
+   */
+  uint16_t size() const { return (uint16_t)(head - tail); }
+
+  /**
+   * @brief Retourner le nombre de paquets perdus car le tampon était plein.
+   */
+  uint32_t getOverflows() const { return overflows; }
+
+  /**
+   * @brief Retourner le nombre d'octets copiés dans les emplacements : 0 si
+   * les paquets sont reçus dans l'emplacement réservé par reserve().
+   */
+  uint32_t getCopiedBytes() const { return copiedBytes; }
+};
+
+uint8_t *PacketRing::reserve() {
+  uint16_t h = head;
+  if ((uint16_t)(h - tail) >= PACKET_RING_SIZE)
+    return nullptr;
+  return slots[h & (PACKET_RING_SIZE - 1)].raw;
+}
+
+bool PacketRing::push(uint16_t universe, uint16_t length, uint8_t sequence,
+                      const uint8_t *data) {
+  uint16_t h = head;
+  if ((uint16_t)(h - tail) >= PACKET_RING_SIZE) {
+    overflows++;
+    return false;
+  }
+
+  DmxPacket &slot = slots[h & (PACKET_RING_SIZE - 1)];
+  if (length > DMX_MAX_CHANNELS)
+    length = DMX_MAX_CHANNELS;
+  slot.opcode = ART_DMX;
+  slot.universe = universe;
+  slot.length = length;
+  slot.sequence = sequence;
+  if (data != slot.data()) {
+    memcpy(slot.data(), data, length);
+    copiedBytes += length;
+  }
+
+  head = h + 1; // publier le paquet une fois qu'il est complet
+  return true;
+}
+
+bool PacketRing::pushPixels(uint16_t frame, uint16_t firstPixel,
+                            uint16_t length, uint8_t sequence, uint8_t flags,
+                            const uint8_t *data) {
+  uint16_t h = head;
+  if ((uint16_t)(h - tail) >= PACKET_RING_SIZE) {
+    overflows++;
+    return false;
+  }
+
+  DmxPacket &slot = slots[h & (PACKET_RING_SIZE - 1)];
+  if (length > MAX_BUFFER_ARTNET - ART_DMX_START)
+    length = MAX_BUFFER_ARTNET - ART_DMX_START;
+  slot.opcode = ART_PIXEL;
+  slot.universe = frame;
+  slot.length = length;
+  slot.sequence = sequence;
+  slot.flags = flags;
+  slot.firstPixel = firstPixel;
+  if (data != slot.data()) {
+    memcpy(slot.data(), data, length);
+    copiedBytes += length;
+  }
+
+  head = h + 1;
+  return true;
+}
+
+bool PacketRing::pushSync() {
+  uint16_t h = head;
+  if ((uint16_t)(h - tail) >= PACKET_RING_SIZE) {
+    overflows++;
+    return false;
+  }
+
+  DmxPacket &slot = slots[h & (PACKET_RING_SIZE - 1)];
+  slot.opcode = ART_SYNC;
+  slot.universe = 0;
+  slot.length = 0;
+  slot.sequence = 0;
+
+  head = h + 1;
+  return true;
+}
+
+DmxPacket *PacketRing::front() {
+  uint16_t t = tail;
+  if (t == head)
+    return nullptr;
+  return &slots[t & (PACKET_RING_SIZE - 1)];
+}
+
+void PacketRing::pop() {
+  if (tail != head)
+    tail = tail + 1;
+}
+
+#endif // PACKETRING_H
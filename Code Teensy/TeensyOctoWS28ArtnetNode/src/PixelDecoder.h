@@ -0,0 +1,258 @@
+/**
+ * @file PixelDecoder.h
+ * @brief Fichier d'en-tête pour la classe PixelDecoder.
+ * @details Décodage des paquets ART_PIXEL compressés (ART_PIXEL_RLE) au fil
+ * des codes, sans tampon intermédiaire, dans une trame de référence RGB. Une
+ * trame clé ne dépend d'aucune autre ; une trame delta (ART_PIXEL_DELTA) ne
+ * transmet que les pixels changés depuis la trame précédente et n'est
+ * décodée que si cette trame a été reçue en entier.
+ *
+ * Données d'un paquet ART_PIXEL_RLE :
+ *  - 0-1 : nombre de pixels du paquet (octet de poids faible en premier)
+ *  - puis des codes de n pixels, n = (code & 0x3F) + 1 :
+ *    - PIXEL_CODE_COPY | n - 1 : n pixels RGB suivent
+ *    - PIXEL_CODE_RUN | n - 1  : un pixel RGB suit, répété n fois
+ *    - PIXEL_CODE_SKIP | n - 1 : n pixels inchangés (trame delta seulement)
+ * @version V0.2.1
+ * @date 2026
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ * Ce programme est un logiciel libre : vous pouvez le redistribuer et/ou le
+ * modifier selon les termes de la Licence Publique Générale GNU publiée par la
+ * Free Software Foundation, soit la version 3 de la licence, soit (à votre
+ * choix) toute version ultérieure.
+ *
+ * Ce programme est distribué dans l'espoir qu'il sera utile,
+ * mais SANS AUCUNE GARANTIE ; sans même la garantie implicite de
+ * QUALITÉ MARCHANDE ou d'ADÉQUATION À UN USAGE PARTICULIER. Voir la
+ * Licence Publique Générale GNU pour plus de détails.
+ *
+ * Vous devriez avoir reçu une copie de la Licence Publique Générale GNU
+ * avec ce programme. Si ce n'est pas le cas, voir
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELDECODER_H
+#define PIXELDECODER_H
+
+#include <Arduino.h>
+#include <Artnet.h>
+
+// Codes des données ART_PIXEL_RLE (2 bits de poids fort)
+#define PIXEL_CODE_COPY 0x00
+#define PIXEL_CODE_RUN 0x40
+#define PIXEL_CODE_SKIP 0x80
+#define PIXEL_CODE_MASK 0xC0
+// Nombre maximum de pixels d'un code
+#define PIXEL_CODE_MAX_PIXELS 64
+
+/**
+ * @struct PixelDecoderStats
+ * @brief Compteurs du décodage.
+ */
+struct PixelDecoderStats {
+  uint32_t packets; // paquets décodés
+  uint32_t dropped; // trames delta sans trame de référence complète
+  uint32_t errors;  // paquets mal formés
+};
+
+/**
+ * @class PixelDecoder
+ * @brief Décode les paquets ART_PIXEL_RLE dans une trame de référence.
+ */
+class PixelDecoder {
+  uint8_t *reference; // trame RGB décodée, modifiée par les trames delta
+  uint16_t numLeds;
+  bool hasReference;       // la trame referenceFrame est complète
+  uint16_t referenceFrame; // numéro de la dernière trame complète
+  PixelDecoderStats stats;
+
+  /**
+   * @brief Compter un paquet mal formé : la trame de référence n'est plus
+   * sûre jusqu'à la prochaine trame clé.
+   */
+  bool fail();
+
+  /**
+   * @brief Parcourir les codes d'un paquet, en écrivant les pixels si WRITE.
+   */
+  template <bool WRITE>
+  bool walk(const uint8_t *data, uint16_t length, uint8_t flags,
+            uint16_t firstPixel);
+
+public:
+  /**
+   * @brief Constructeur pour PixelDecoder.
+   */
+  PixelDecoder();
+
+  /**
+   * @brief Définir la trame de référence.
+   * @param buffer Tableau de numLeds * 3 octets, nullptr pour ne plus
+   * décoder.
+   * @param _numLeds Nombre de LEDs de la trame.
+   */
+  void begin(uint8_t *buffer, uint16_t _numLeds);
+
+  /**
+   * @brief Retourner true si une trame de référence est définie.
+   */
+  bool isEnabled() const { return reference != nullptr; }
+
+  /**
+   * @brief Retourner le nombre de pixels d'un paquet ART_PIXEL_RLE.
+   * @param data Données du paquet.
+   * @param length Longueur des données.
+   */
+  static uint16_t pixelCount(const uint8_t *data, uint16_t length) {
+    return length >= 2 ? data[0] | data[1] << 8 : 0;
+  }
+
+  /**
+   * @brief Retourner true si un paquet de la trame peut être décodé : une
+   * trame delta n'est décodée que si la trame précédente est complète.
+   * @param frame Numéro de trame.
+   * @param flags Drapeaux du paquet.
+   */
+  bool canDecode(uint16_t frame, uint8_t flags) const;
+
+  /**
+   * @brief Compter un paquet écarté par canDecode().
+   */
+  void drop() { stats.dropped++; }
+
+  /**
+   * @brief Vérifier les codes d'un paquet sans rien écrire.
+   * @details À appeler avant de compter les pixels du paquet dans la trame :
+   * un paquet accepté par check() est ensuite décodé en entier.
+   * @param data Données du paquet.
+   * @param length Longueur des données.
+   * @param flags Drapeaux du paquet.
+   * @return False si le paquet est mal formé.
+   */
+  bool check(const uint8_t *data, uint16_t length, uint8_t flags) {
+    return walk<false>(data, length, flags, 0);
+  }
+
+  /**
+   * @brief Décoder un paquet dans la trame de référence.
+   * @details Les pixels au-delà de numLeds sont lus mais pas écrits. Un
+   * paquet mal formé peut avoir été écrit en partie.
+   * @param data Données du paquet.
+   * @param length Longueur des données.
+   * @param flags Drapeaux du paquet.
+   * @param firstPixel Index du premier pixel du paquet.
+   * @return False si le paquet est mal formé.
+   */
+  bool decode(const uint8_t *data, uint16_t length, uint8_t flags,
+              uint16_t firstPixel) {
+    return walk<true>(data, length, flags, firstPixel);
+  }
+
+  /**
+   * @brief Marquer la trame comme complète : elle sert de référence à la
+   * trame delta suivante.
+   * @param frame Numéro de trame.
+   */
+  void setReference(uint16_t frame) {
+    hasReference = true;
+    referenceFrame = frame;
+  }
+
+  /**
+   * @brief Retourner les pixels décodés à partir de firstPixel.
+   */
+  const uint8_t *pixels(uint16_t firstPixel) const {
+    return reference + (firstPixel < numLeds ? firstPixel : numLeds) * 3;
+  }
+
+  /**
+   * @brief Retourner les compteurs du décodage.
+   */
+  const PixelDecoderStats &getStats() const { return stats; }
+};
+
+PixelDecoder::PixelDecoder()
+    : reference(nullptr), numLeds(0), hasReference(false), referenceFrame(0) {
+  memset(&stats, 0, sizeof(stats));
+}
+
+void PixelDecoder::begin(uint8_t *buffer, uint16_t _numLeds) {
+  reference = buffer;
+  numLeds = _numLeds;
+  hasReference = false;
+  if (reference)
+    memset(reference, 0, numLeds * 3);
+}
+
+bool PixelDecoder::canDecode(uint16_t frame, uint8_t flags) const {
+  if (!reference)
+    return false;
+  if (!(flags & ART_PIXEL_DELTA))
+    return true;
+  return hasReference && referenceFrame == (uint16_t)(frame - 1);
+}
+
+template <bool WRITE>
+bool PixelDecoder::walk(const uint8_t *data, uint16_t length, uint8_t flags,
+                        uint16_t firstPixel) {
+  if (length < 2)
+    return fail();
+  const uint8_t *in = data + 2;
+  const uint8_t *end = data + length;
+  uint32_t pixel = firstPixel;
+  uint32_t last = pixel + pixelCount(data, length);
+
+  while (in < end) {
+    uint8_t code = *in++;
+    uint16_t n = (code & ~PIXEL_CODE_MASK) + 1;
+    if (pixel + n > last)
+      return fail();
+    // pixels à écrire dans la trame
+    uint16_t room = WRITE && pixel < numLeds ? numLeds - pixel : 0;
+    if (room > n)
+      room = n;
+    uint8_t *out = reference + (room ? pixel * 3 : 0);
+
+    switch (code & PIXEL_CODE_MASK) {
+    case PIXEL_CODE_COPY:
+      if (end - in < n * 3)
+        return fail();
+      memcpy(out, in, room * 3);
+      in += n * 3;
+      break;
+    case PIXEL_CODE_RUN:
+      if (end - in < 3)
+        return fail();
+      for (uint16_t i = 0; i < room; i++, out += 3) {
+        out[0] = in[0];
+        out[1] = in[1];
+        out[2] = in[2];
+      }
+      in += 3;
+      break;
+    case PIXEL_CODE_SKIP:
+      if (!(flags & ART_PIXEL_DELTA))
+        return fail();
+      break;
+    default:
+      return fail();
+    }
+    pixel += n;
+  }
+
+  if (pixel != last)
+    return fail();
+  if (WRITE)
+    stats.packets++;
+  return true;
+}
+
+bool PixelDecoder::fail() {
+  stats.errors++;
+  hasReference = false;
+  return false;
+}
+
+#endif // PIXELDECODER_H
@@ -0,0 +1,294 @@
+/**
+ * @file PowerBudget.h
+ * @brief Fichier d'en-tête pour la classe PowerBudget.
+ * @details Estimation du courant de chaque trame par groupe d'injection
+ * d'alimentation, et limitation au budget de chaque groupe. Les sommes des
+ * composantes sont accumulées pendant la conversion des couleurs
+ * (ColorKernel), la limitation ne repasse sur les pixels que pour les groupes
+ * qui dépassent leur budget.
+ * @version V0.2.1
+ * @date 2026
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ * Ce programme est un logiciel libre : vous pouvez le redistribuer et/ou le
+ * modifier selon les termes de la Licence Publique Générale GNU publiée par la
+ * Free Software Foundation, soit la version 3 de la licence, soit (à votre
+ * choix) toute version ultérieure.
+ *
+ * Ce programme est distribué dans l'espoir qu'il sera utile,
+ * mais SANS AUCUNE GARANTIE ; sans même la garantie implicite de
+ * QUALITÉ MARCHANDE ou d'ADÉQUATION À UN USAGE PARTICULIER. Voir la
+ * Licence Publique Générale GNU pour plus de détails.
+ *
+ * Vous devriez avoir reçu une copie de la Licence Publique Générale GNU
+ * avec ce programme. Si ce n'est pas le cas, voir
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef POWERBUDGET_H
+#define POWERBUDGET_H
+
+#include <Arduino.h>
+
+// Nombre maximum de groupes d'injection
+#ifndef POWER_MAX_GROUPS
+#define POWER_MAX_GROUPS 8
+#endif
+
+// Nombre maximum de suites de pins consécutives d'un même groupe
+#ifndef POWER_MAX_SEGMENTS
+#define POWER_MAX_SEGMENTS 64
+#endif
+
+// Facteur d'échelle 1.0 en virgule fixe 16.16
+#define POWER_SCALE_ONE 65536UL
+
+/**
+ * @struct PowerGroupStats
+ * @brief Télémétrie d'un groupe d'injection pour la dernière trame.
+ */
+struct PowerGroupStats {
+  uint32_t budget;        // budget en mA (0 : pas de limite)
+  uint32_t current;       // courant estimé avant limitation, en mA
+  int32_t headroom;       // budget - courant, négatif si la trame est limitée
+  uint32_t scale;         // échelle appliquée, POWER_SCALE_ONE sans limite
+  uint32_t limitedFrames; // trames limitées depuis le démarrage
+};
+
+/**
+ * @class PowerBudget
+ * @brief Limite le courant de chaque groupe d'injection au budget configuré.
+ * @details Le courant d'une LED est proportionnel à la valeur envoyée sur
+ * chaque composante : la somme des valeurs de sortie suffit à l'estimer. Si
+ * un groupe dépasse son budget, tous ses pixels sont multipliés par la plus
+ * grande échelle qui le ramène sous le budget.
+ */
+class PowerBudget {
+  struct Segment {
+    uint16_t firstPixel;
+    uint16_t endPixel;
+    uint8_t group;
+  };
+
+  Segment segments[POWER_MAX_SEGMENTS];
+  uint8_t numSegments;
+  uint8_t cursor; // dernier segment trouvé, les univers arrivent dans l'ordre
+  uint8_t numGroups;
+  uint32_t sums[POWER_MAX_GROUPS][4]; // somme des valeurs R, G, B et W
+  uint16_t pixels[POWER_MAX_GROUPS];
+  PowerGroupStats stats[POWER_MAX_GROUPS];
+  uint16_t channelMa[4]; // courant d'une composante à 255, en mA
+  uint16_t idleUa;       // courant d'une LED éteinte, en µA
+
+  /**
+   * @brief Multiplier les pixels d'un groupe par scale (16.16).
+   */
+  void scaleGroup(uint8_t group, uint8_t *frame, uint8_t bytesPerPixel,
+                  uint32_t scale);
+
+public:
+  /**
+   * @brief Constructeur pour PowerBudget (désactivé, aucun groupe).
+   */
+  PowerBudget();
+
+  /**
+   * @brief Définir le groupe d'injection de chaque pin.
+   * @param pinGroup Numéro de groupe de chaque pin, dans l'ordre de pinList.
+   * @param stripLengths Nombre de LEDs de chaque pin, dans le même ordre.
+   * @param numPins Nombre de pins.
+   * @return False si un groupe dépasse POWER_MAX_GROUPS ou s'il y a trop de
+   * suites de pins (POWER_MAX_SEGMENTS).
+   */
+  bool setGroups(const uint8_t *pinGroup, const uint16_t *stripLengths,
+                 uint8_t numPins);
+
+  /**
+   * @brief Retourner le courant des LEDs éteintes d'un groupe, en mA.
+   */
+  uint32_t idleCurrent(uint8_t group) const {
+    return group < POWER_MAX_GROUPS ? (uint32_t)pixels[group] * idleUa / 1000
+                                    : 0;
+  }
+
+  /**
+   * @brief Définir le budget d'un groupe.
+   * @details À appeler après setGroups() et setChannelCurrent().
+   * @param group Numéro du groupe.
+   * @param milliamps Courant maximum en mA, 0 pour ne pas limiter.
+   * @return False si le budget ne couvre pas le courant des LEDs éteintes
+   * du groupe : le groupe resterait noir.
+   */
+  bool setBudget(uint8_t group, uint32_t milliamps);
+
+  /**
+   * @brief Définir le courant des LEDs.
+   * @param r Courant de la composante rouge à 255, en mA.
+   * @param g Courant de la composante verte à 255, en mA.
+   * @param b Courant de la composante bleue à 255, en mA.
+   * @param w Courant de la composante blanche à 255, en mA.
+   * @param idle Courant d'une LED éteinte, en µA.
+   */
+  void setChannelCurrent(uint16_t r, uint16_t g, uint16_t b, uint16_t w,
+                         uint16_t idle);
+
+  /**
+   * @brief Retourner true si des groupes ont été définis.
+   */
+  bool isEnabled() const { return numSegments > 0; }
+
+  /**
+   * @brief Retourner les sommes du groupe qui contient un pixel.
+   * @param pixel Index du pixel dans la trame.
+   * @param count Nombre de pixels à convertir, réduit à la fin du segment.
+   * @return Sommes à passer à ColorKernel::apply(), nullptr si le pixel
+   * n'appartient à aucun groupe.
+   */
+  uint32_t *sumsAt(uint16_t pixel, uint16_t &count);
+
+  /**
+   * @brief Oublier les sommes de la trame en cours.
+   */
+  void reset() { memset(sums, 0, sizeof(sums)); }
+
+  /**
+   * @brief Estimer le courant de la trame, limiter les groupes qui dépassent
+   * leur budget et commencer une nouvelle trame.
+   * @param frame Tampon de dessin, pixels au format de sortie.
+   * @param bytesPerPixel Nombre d'octets d'un pixel (3 ou 4).
+   */
+  void limit(uint8_t *frame, uint8_t bytesPerPixel);
+
+  /**
+   * @brief Retourner le nombre de groupes.
+   */
+  uint8_t getNumGroups() const { return numGroups; }
+
+  /**
+   * @brief Retourner la télémétrie d'un groupe.
+   */
+  const PowerGroupStats &getStats(uint8_t group) const {
+    return stats[group];
+  }
+};
+
+PowerBudget::PowerBudget()
+    : numSegments(0), cursor(0), numGroups(0), channelMa{20, 20, 20, 20},
+      idleUa(1000) {
+  memset(sums, 0, sizeof(sums));
+  memset(pixels, 0, sizeof(pixels));
+  memset(stats, 0, sizeof(stats));
+  for (uint8_t g = 0; g < POWER_MAX_GROUPS; g++)
+    stats[g].scale = POWER_SCALE_ONE;
+}
+
+bool PowerBudget::setGroups(const uint8_t *pinGroup,
+                            const uint16_t *stripLengths, uint8_t numPins) {
+  numSegments = 0;
+  numGroups = 0;
+  memset(pixels, 0, sizeof(pixels));
+  uint16_t pixel = 0;
+  for (uint8_t i = 0; i < numPins; i++) {
+    uint8_t group = pinGroup[i];
+    if (group >= POWER_MAX_GROUPS) {
+      numSegments = 0;
+      return false;
+    }
+    if (group >= numGroups)
+      numGroups = group + 1;
+    pixels[group] += stripLengths[i];
+
+    // Les pins consécutives d'un même groupe forment un seul segment
+    if (numSegments && segments[numSegments - 1].group == group) {
+      segments[numSegments - 1].endPixel += stripLengths[i];
+    } else {
+      if (numSegments >= POWER_MAX_SEGMENTS) {
+        numSegments = 0;
+        return false;
+      }
+      segments[numSegments++] = {pixel, (uint16_t)(pixel + stripLengths[i]),
+                                 group};
+    }
+    pixel += stripLengths[i];
+  }
+  cursor = 0;
+  reset();
+  return true;
+}
+
+bool PowerBudget::setBudget(uint8_t group, uint32_t milliamps) {
+  if (group >= POWER_MAX_GROUPS)
+    return false;
+  stats[group].budget = milliamps;
+  return !milliamps || milliamps > idleCurrent(group);
+}
+
+void PowerBudget::setChannelCurrent(uint16_t r, uint16_t g, uint16_t b,
+                                    uint16_t w, uint16_t idle) {
+  channelMa[0] = r;
+  channelMa[1] = g;
+  channelMa[2] = b;
+  channelMa[3] = w;
+  idleUa = idle;
+}
+
+uint32_t *PowerBudget::sumsAt(uint16_t pixel, uint16_t &count) {
+  for (uint8_t n = 0; n < numSegments; n++) {
+    const Segment &s = segments[cursor];
+    if (pixel >= s.firstPixel && pixel < s.endPixel) {
+      if (count > s.endPixel - pixel)
+        count = s.endPixel - pixel;
+      return sums[s.group];
+    }
+    cursor = cursor + 1 < numSegments ? cursor + 1 : 0;
+  }
+  return nullptr;
+}
+
+void PowerBudget::limit(uint8_t *frame, uint8_t bytesPerPixel) {
+  for (uint8_t g = 0; g < numGroups; g++) {
+    PowerGroupStats &st = stats[g];
+    uint64_t dynamic = 0;
+    for (uint8_t c = 0; c < 4; c++)
+      dynamic += (uint64_t)sums[g][c] * channelMa[c];
+    dynamic /= 255;
+    uint32_t idle = idleCurrent(g);
+    st.current = idle + dynamic;
+    st.headroom = (int32_t)st.budget - (int32_t)st.current;
+    st.scale = POWER_SCALE_ONE;
+    if (!st.budget || st.current <= st.budget)
+      continue;
+
+    // Seule la partie dynamique diminue avec les valeurs des pixels. Une
+    // trame noire au-dessus du budget (courant des LEDs éteintes seul) ne
+    // peut pas être réduite.
+    st.limitedFrames++;
+    if (!dynamic) {
+      st.scale = 0;
+      continue;
+    }
+    uint32_t allowed = st.budget > idle ? st.budget - idle : 0;
+    st.scale = (uint32_t)((uint64_t)allowed * POWER_SCALE_ONE / dynamic);
+    scaleGroup(g, frame, bytesPerPixel, st.scale);
+  }
+  reset();
+}
+
+void PowerBudget::scaleGroup(uint8_t group, uint8_t *frame,
+                             uint8_t bytesPerPixel, uint32_t scale) {
+  for (uint8_t n = 0; n < numSegments; n++) {
+    const Segment &s = segments[n];
+    if (s.group != group)
+      continue;
+    uint8_t *p = frame + s.firstPixel * bytesPerPixel;
+    uint8_t *end = frame + s.endPixel * bytesPerPixel;
+    // Arrondi vers le bas : le courant reste sous le budget
+    while (p < end) {
+      *p = (*p * scale) >> 16;
+      p++;
+    }
+  }
+}
+
+#endif // POWERBUDGET_H
@@ -0,0 +1,109 @@
+/**
+ * @file TDWS2811Backend.h
+ * @brief Fichier d'en-tête pour la classe TDWS2811Backend.
+ * @details Sortie par TriantaduoWS2811 : 32 bandes par registres à décalage
+ * pilotés en FlexIO sur 3 broches. La trame est dessinée dans un tampon
+ * d'octets, prepare() la transpose dans le tampon inactif du pilote
+ * (PixelDriver::setInactiveStripSpan) et startOutput() échange les tampons.
+ * @version V0.2.1
+ * @date 2026
+ *
+ * @copyright GNU General Public License v3.0
+ *
+ * Ce programme est un logiciel libre : vous pouvez le redistribuer et/ou le
+ * modifier selon les termes de la Licence Publique Générale GNU publiée par la
+ * Free Software Foundation, soit la version 3 de la licence, soit (à votre
+ * choix) toute version ultérieure.
+ *
+ * Ce programme est distribué dans l'espoir qu'il sera utile,
+ * mais SANS AUCUNE GARANTIE ; sans même la garantie implicite de
+ * QUALITÉ MARCHANDE ou d'ADÉQUATION À UN USAGE PARTICULIER. Voir la
+ * Licence Publique Générale GNU pour plus de détails.
+ *
+ * Vous devriez avoir reçu une copie de la Licence Publique Générale GNU
+ * avec ce programme. Si ce n'est pas le cas, voir
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TDWS2811BACKEND_H
+#define TDWS2811BACKEND_H
+
+#include "OutputBackend.h"
+#include <OctoWS2811.h>
+#include <TDWS2811.h>
+
+/**
+ * @class TDWS2811Backend
+ * @brief Interface OutputBackend pour TriantaduoWS2811 en DOUBLE_BUFFER.
+ */
+class TDWS2811Backend : public OutputBackend {
+  TDWS28XX::PixelDriver *pdriver;
+  uint8_t *drawBuffer;
+  uint8_t numStrips;
+  const uint16_t *stripLengths;
+  uint8_t bytesPerPixel;
+  bool spanError; // une bande n'a pas pu être transposée
+  OutputCapabilities caps;
+
+public:
+  /**
+   * @brief Constructeur pour TDWS2811Backend.
+   * @details Définit le type de chaque canal : GRBW pour les ordres à 4
+   * octets, sinon 3 octets envoyés dans l'ordre de config.
+   * @param _pdriver Pointeur vers le PixelDriver (DOUBLE_BUFFER), begin()
+   * déjà appelé.
+   * @param _drawBuffer Tampon de dessin, de la taille de la trame.
+   * @param config Ordre des couleurs de la bande (WS2811_GRBW...).
+   * @param _numStrips Nombre de bandes (canaux 0 à _numStrips - 1).
+   * @param _stripLengths Nombre de LEDs de chaque bande.
+   */
+  TDWS2811Backend(TDWS28XX::PixelDriver *_pdriver, void *_drawBuffer,
+                  uint8_t config, uint8_t _numStrips,
+                  const uint16_t *_stripLengths)
+      : pdriver(_pdriver), drawBuffer((uint8_t *)_drawBuffer),
+        numStrips(_numStrips), stripLengths(_stripLengths),
+        bytesPerPixel((config & 0x1F) < 6 ? 3 : 4), spanError(false),
+        caps{"TDWS2811", 32, (uint8_t)(config & 0x1F), true, true} {
+    for (uint8_t c = 0; c < numStrips && c < 32; c++)
+      pdriver->setChannelType(c, bytesPerPixel == 4 ? TDWS28XX::GRBW
+                                                    : TDWS28XX::RGB);
+  }
+
+  const OutputCapabilities &capabilities() const override { return caps; }
+
+  uint8_t *getDrawBuffer() override { return drawBuffer; }
+
+  /**
+   * @brief Retourner true si le dernier prepare() n'a pas pu transposer une
+   * bande : plus de 32 bandes, ou bande plus longue que le PixelBuffer.
+   */
+  bool hasSpanError() const { return spanError; }
+
+  void prepare(uint8_t *frame) override {
+    // Les bandes consécutives de même longueur sont transposées ensemble
+    const uint8_t *pixels = frame;
+    uint8_t c = 0;
+    spanError = false;
+    while (c < numStrips) {
+      uint8_t n = 1;
+      while (c + n < numStrips && stripLengths[c + n] == stripLengths[c])
+        n++;
+      if (!pdriver->setInactiveStripSpan(c, n, 0, stripLengths[c], pixels))
+        spanError = true;
+      pixels += n * stripLengths[c] * bytesPerPixel;
+      c += n;
+    }
+  }
+
+  bool startOutput() override {
+    if (!pdriver->bufferReady())
+      return false;
+    pdriver->flipBuffers();
+    return true;
+  }
+
+  bool isBusy() override { return !pdriver->bufferReady(); }
+};
+
+#endif // TDWS2811BACKEND_H
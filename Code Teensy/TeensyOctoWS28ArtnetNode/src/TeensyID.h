@@ -57,7 +57,7 @@ public:
 void TeensyID::getMAC(uint8_t *mac) {
   static char teensyMac[23];
 #if defined(HW_OCOTP_MAC1) && defined(HW_OCOTP_MAC0)
-  Debug::println("using HW_OCOTP_MAC* - see https://forum.pjrc.com/threads/57595-Serial-amp-MAC-Address-Teensy-4-0");
+  DEBUG_INFO("using HW_OCOTP_MAC* - see https://forum.pjrc.com/threads/57595-Serial-amp-MAC-Address-Teensy-4-0\n");
   for (uint8_t by = 0; by < 2; by++)
     mac[by] = (HW_OCOTP_MAC1 >> ((1 - by) * 8)) & 0xFF;
   for (uint8_t by = 0; by < 4; by++)
@@ -70,7 +70,7 @@ void TeensyID::getMAC(uint8_t *mac) {
   uint32_t SN = 0;
   __disable_irq();
 #if defined(HAS_KINETIS_FLASH_FTFA) || defined(HAS_KINETIS_FLASH_FTFL)
-  Debug::println("using FTFL_FSTAT_FTFA - vis teensyID.h - see https://github.com/sstaub/TeensyID/blob/master/TeensyID.h");
+  DEBUG_INFO("using FTFL_FSTAT_FTFA - vis teensyID.h - see https://github.com/sstaub/TeensyID/blob/master/TeensyID.h\n");
   FTFL_FSTAT = FTFL_FSTAT_RDCOLERR | FTFL_FSTAT_ACCERR | FTFL_FSTAT_FPVIOL;
   FTFL_FCCOB0 = 0x41;
   FTFL_FCCOB1 = 15;
@@ -80,7 +80,7 @@ void TeensyID::getMAC(uint8_t *mac) {
   SN = *(uint32_t *)&FTFL_FCCOB7;
 #define MAC_OK
 #elif defined(HAS_KINETIS_FLASH_FTFE)
-  Debug::println("using FTFL_FSTAT_FTFE - vis teensyID.h - see https://github.com/sstaub/TeensyID/blob/master/TeensyID.h");
+  DEBUG_INFO("using FTFL_FSTAT_FTFE - vis teensyID.h - see https://github.com/sstaub/TeensyID/blob/master/TeensyID.h\n");
   kinetis_hsrun_disable();
   FTFL_FSTAT = FTFL_FSTAT_RDCOLERR | FTFL_FSTAT_ACCERR | FTFL_FSTAT_FPVIOL;
   *(uint32_t *)&FTFL_FCCOB3 = 0x41070000;
@@ -98,9 +98,9 @@ void TeensyID::getMAC(uint8_t *mac) {
 
 #ifdef MAC_OK
   sprintf(teensyMac, "MAC: %02x:%02x:%02x:%02x:%02x:%02x", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-  Debug::println(teensyMac);
+  DEBUG_INFO("%s\n", teensyMac);
 #else
-  Debug::println("ERROR: could not get MAC");
+  DEBUG_ERROR("ERROR: could not get MAC\n");
 #endif
 }
 
@@ -114,11 +114,11 @@ void TeensyID::initializeEEPROM(byte *ip) {
 
   if (EEPROM.read(10) == 0 || EEPROM.read(10) >= 255)
   {
-    Debug::println("EEPROM not set.. using defaut id: 254");
+    DEBUG_INFO("EEPROM not set.. using defaut id: 254\n");
     EEPROM.write(10, 254); 
   }
   delay(500);
-  Debug::printf("EEPROM.read(10) = %d \n", EEPROM.read(10));
+  DEBUG_INFO("EEPROM.read(10) = %d \n", EEPROM.read(10));
   ip[3] = EEPROM.read(10); // Correction de l'affectation de l'adresse IP
 }
 
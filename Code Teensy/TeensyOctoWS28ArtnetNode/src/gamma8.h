@@ -1,4 +1,7 @@
 
+#ifndef GAMMA8_H
+#define GAMMA8_H
+
 // LED light gamma lookup table
 const uint8_t PROGMEM gamma8[] = {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -33,3 +36,5 @@ uint8_t gg8(uint8_t g) {
 uint8_t bg8(uint8_t b) {
     return min(255, (gamma8[b] * bf));
 }
+
+#endif // GAMMA8_H
@@ -25,9 +25,22 @@
  */
 
 #include "Debug.h"
+#include "OutputBackend.h"
+#include "PacketRing.h"
 #include "TeensyID.h"
 #include "gamma8.h"
+// LED driver, chosen by the PlatformIO env (LED_BACKEND build flag)
+#if LED_BACKEND == LED_BACKEND_OBJECTFLED
+#include "ObjectFLEDBackend.h" // must be included before FastLED.h
+#elif LED_BACKEND == LED_BACKEND_TDWS2811
+#include "TDWS2811Backend.h"
+#elif LED_BACKEND == LED_BACKEND_MEMORY
+#include "MemoryBackend.h"
+#else
+#include "OctoBackend.h"
+#endif
 #include <Artnet.h>
+#include <E131.h>
 #include <EEPROM.h>
 #include <FastLED.h>
 #include <NativeEthernet.h>
@@ -35,13 +48,33 @@
 #include <OctoWS2811.h>
 #include <SPI.h>
 
-// Set to 1 to enable debug output
+// Set to 1 to enable debug output. The messages compiled in are chosen by
+// DEBUG_LEVEL (src/Debug.h), -D DEBUG_LEVEL=DEBUG_LEVEL_TRACE adds an event
+// per packet and per frame, printed when the loop is idle.
 const int debug_set = 1;
 
 // Set to 0 to disable Artnet and run a test pattern or 1 to enable Artnet
 const int artnet_set = 1;
-// To help with logevity, brightness is set to ~50% (0-255) = 30A in full white
-const int BRIGHTNESS = 200;
+// Set to 1 to receive E1.31 (sACN) on the multicast groups of the node's
+// universes only (sacnFirstUniverse...). With sACN senders, artnet_set = 0
+// stops the node from reading the Art-Net broadcast of the whole show.
+// Opens one socket per universe: check the joined groups on the first boot.
+const int sacn_set = 0;
+// Set to 1 to latch frames on ArtSync when the sender emits it
+const int artsync_set = 1;
+// Without ArtSync for this long, frames are shown as soon as all universes are
+// received (4s as in the Art-Net specification)
+const unsigned long ARTSYNC_TIMEOUT_MS = 4000;
+// Set to 1 to limit the current of each power injection group (powerGroup,
+// POWER_GROUP_BUDGET_MA) instead of derating the brightness of every frame.
+// Keep 0 until LED_CHANNEL_MA and LED_IDLE_UA hold values measured on the
+// strips of the layout.
+const int power_set = 0;
+// Without power budget, brightness is set to ~80% (0-255) = 30A in full white
+// to help with longevity
+const int BRIGHTNESS = power_set == 1 ? 255 : 200;
+// Set to 1 to apply the gamma curves of gamma8.h (rg8, gg8, bg8) on output
+const int gamma_set = 1;
 const int blackout_pin = 40;
 /*
  COLOR_CORRECTION
@@ -57,9 +90,18 @@ const int COLOR_CORRECTION = UncorrectedColor;
 // ie. 510 leds / 3 universes per pin
 const int FRAMES_PER_SECOND = 30;
 
+// Time budget given to Artnet (and to sACN) on each loop to drain the pending
+// packets
+const uint32_t ARTNET_READ_BUDGET_US = 1000;
+
+// Interval between two prints of the frame counters (0 to disable)
+const unsigned long STATS_INTERVAL_MS = 10000;
+
 // CHANGE FOR YOUR SETUP most software this is 1, some software send out artnet
 // first universe as 0.
 const int startUniverse = 0;
+// sACN universe received as startUniverse (sACN universes start at 1)
+const int sacnFirstUniverse = 1;
 
 // Network IP addresses
 byte ip[] = {2, 12, 0, 254}; // IP address of the node (254 is default, will be
@@ -73,6 +115,14 @@ const byte pinList[numPins] = {
     31, 32, 33, 34, 35, 36, 37, 38, 39}; // List of pins used for LED output
 const int Led_for_one_strip = 108;       // Number of LEDs per strip
 const int Nb_string_strip = 2;           // Number of strips per pin
+// Number of LEDs on each pin, in pinList order (shorter edge strips)
+constexpr uint16_t stripLengths[numPins] = {
+    216, 216, 216, 216, 216, 216, 216, 216, 216,
+    216, 216, 216, 216, 216, 216, 216, 216, 216};
+// Power injection group of each pin, in pinList order
+const uint8_t powerGroup[numPins] = {0, 0, 0, 0, 0, 0, 1, 1, 1,
+                                     1, 1, 1, 2, 2, 2, 2, 2, 2};
+const int numPowerGroups = 3;
 #endif
 
 // Etendard V1.a (KXKM)
@@ -83,6 +133,14 @@ const byte pinList[numPins] = {
     24, 12, 11, 10, 9,  8,  7,  6,  5}; // List of pins used for LED output
 const int Led_for_one_strip = 138;      // Number of LEDs per strip
 const int Nb_string_strip = 2;          // Number of strips per pin
+// Number of LEDs on each pin, in pinList order (shorter edge strips)
+constexpr uint16_t stripLengths[numPins] = {
+    276, 276, 276, 276, 276, 276, 276, 276, 276,
+    276, 276, 276, 276, 276, 276, 276, 276, 276};
+// Power injection group of each pin, in pinList order
+const uint8_t powerGroup[numPins] = {0, 0, 0, 0, 0, 0, 1, 1, 1,
+                                     1, 1, 1, 2, 2, 2, 2, 2, 2};
+const int numPowerGroups = 3;
 #endif
 
 // Etendard V2.a (KXKM) version with 1 strip of 138 LEDs per pin in 36 output
@@ -96,42 +154,147 @@ const byte pinList[numPins] = {23, 22, 21, 20, 18, 17, 16, 15, 14, 13,
                                                        // LED output
 const int Led_for_one_strip = 138; // Number of LEDs per strip
 const int Nb_string_strip = 1;     // Number of strips per pin
+// Number of LEDs on each pin, in pinList order (shorter edge strips)
+constexpr uint16_t stripLengths[numPins] = {
+    138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138,
+    138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138,
+    138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138, 138};
+// Power injection group of each pin, in pinList order
+const uint8_t powerGroup[numPins] = {0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1,
+                                     2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3,
+                                     4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5};
+const int numPowerGroups = 6;
 #endif
 
-// calculate the number of leds per strip and the total number of leds in the
-// system
-const int ledsPerStrip = Led_for_one_strip * Nb_string_strip;
+// Current budget of each power injection group (30A in total)
+const uint32_t POWER_GROUP_BUDGET_MA = 30000 / numPowerGroups;
+// Current of one LED channel at 255 and of an LED off, measure it for your
+// strips (mA, mA, mA, mA, uA)
+const uint16_t LED_CHANNEL_MA[4] = {12, 12, 12, 12};
+const uint16_t LED_IDLE_UA = 1000;
+
+constexpr int max2(int a, int b) { return a > b ? a : b; }
+
+// Sum of the strip lengths
+constexpr int sumLengths(const uint16_t *lengths, int count) {
+  return count == 0 ? 0 : lengths[0] + sumLengths(lengths + 1, count - 1);
+}
+
+// Longest strip
+constexpr int maxLength(const uint16_t *lengths, int count) {
+  return count == 0 ? 0 : max2(lengths[0], maxLength(lengths + 1, count - 1));
+}
+
+// calculate the number of leds of the longest strip and the total number of
+// leds in the system. The strips are stored one after the other, the buffers
+// only hold the real number of leds.
+const int ledsPerStrip = maxLength(stripLengths, numPins);
 const byte numStrips = numPins;
-const int numLeds = ledsPerStrip * numStrips;
+const int numLeds = sumLengths(stripLengths, numPins);
 const int numberOfChannels = numLeds * 3;
 
 // Define your FastLED pixels
-CRGB rgbarray[numPins * ledsPerStrip];
+CRGB rgbarray[numLeds];
+// Universes are assembled here, then swapped with rgbarray
+CRGB rgbback[numLeds];
+// Last frame of the compressed ART_PIXEL packets, delta frames apply to it
+uint8_t pixelReference[numberOfChannels];
 
 // Memory buffer to artnet data
 /* These buffers need to be large enough for all the pixels.
- The total number of pixels is "ledsPerStrip * numPins".
+ The total number of pixels is "numLeds".
  Each pixel needs 3 bytes (or 4 in RGBW), so multiply by 3.  An "int" is
  4 bytes, so divide by 4.  The array is created using "int"
  so the compiler will align it to 32 bit memory.
  */
 
-DMAMEM int displayMemory[ledsPerStrip * numPins * 4 / 4];
-int drawingMemory[ledsPerStrip * numPins * 4 / 4];
+int drawingMemory[numLeds * 4 / 4];
+
+// Color order and speed of the LED strips
+const uint8_t ledConfig = WS2811_GRBW | WS2811_800kHz;
+
+#if LED_BACKEND == LED_BACKEND_OBJECTFLED
+// ObjectFLED reads drawingMemory as RGB pixels and sends them in GRBW order
+ObjectFLED fled(numLeds, drawingMemory, CORDER_GRBW, numPins, pinList);
+ObjectFLEDBackend fledOutput(&fled, drawingMemory);
+OutputBackend *output = &fledOutput;
+
+#elif LED_BACKEND == LED_BACKEND_TDWS2811
+// Up to 32 strips on shift registers: SRCLK, RCLK and SER pins of FLEXIO1
+const TDWS28XX::FlexPins tdwsPins = {2, 3, 4};
+TDWS28XX::PixelBuffer<ledsPerStrip, TDWS28XX::QUADCOLOR,
+                      TDWS28XX::DOUBLE_BUFFER>
+    tdwsBuffer;
+TDWS28XX::PixelDriver tdws(tdwsBuffer);
+TDWS2811Backend tdwsOutput(&tdws, drawingMemory, ledConfig, numStrips,
+                           stripLengths);
+OutputBackend *output = &tdwsOutput;
+
+#elif LED_BACKEND == LED_BACKEND_MEMORY
+// Host build: frames are sent to ledMemory, the output stays busy as long as
+// the WS2811 waveform of the longest strip would (1.25us per bit + reset)
+int queueMemory[numLeds * 4 / 4];
+int ledMemory[numLeds * 4 / 4];
+const uint32_t outputMicros = ledsPerStrip * 4 * 8 * 5 / 4 + 300;
+MemoryBackend memoryOutput(drawingMemory, queueMemory, ledMemory,
+                           sizeof(drawingMemory), ledConfig, outputMicros);
+OutputBackend *output = &memoryOutput;
+
+#else
+DMAMEM int displayMemory[numLeds * 4 / 4];
+// Third buffer: a complete frame waits here while the previous one is sent,
+// the next frame is assembled without waiting for the output
+int spareMemory[numLeds * 4 / 4];
+
+// Set to 1 to convert the whole frame to GPIO bit planes in show(), DMA then
+// sends it with no interrupt (~70KB of RAM2 for V2.a, 140KB for V1.a)
+const int fullframe_set = 1;
+DMAMEM uint32_t bitBuffer[OCTOWS2811_BITBUFFER_SIZE(ledsPerStrip, 4) / 4]
+    __attribute__((aligned(32)));
 
 // Initialize Octo library using FastLED Controller
-OctoWS2811 octo(ledsPerStrip, displayMemory, drawingMemory,
-                WS2811_GRBW | WS2811_800kHz, numPins, pinList);
+OctoWS2811 octo(ledsPerStrip, displayMemory, drawingMemory, ledConfig, numPins,
+                pinList);
+OctoBackend octoOutput(&octo, ledConfig, true);
+OutputBackend *output = &octoOutput;
+#endif
 
 // Artnet settings
 Artnet artnet;
+E131 e131;
 
-// Check if we got all universes
+// Each universe carries 170 RGB pixels (510 channels)
+const int pixelsPerUniverse = 170;
 const int maxUniverses =
-    numberOfChannels / 512 + ((numberOfChannels % 512) ? 1 : 0);
-bool universesReceived[maxUniverses];
-bool sendFrame = 1;
-int previousDataLength = 0;
+    numLeds / pixelsPerUniverse + ((numLeds % pixelsPerUniverse) ? 1 : 0);
+
+// Packets received from Artnet, waiting for the render stage
+PacketRing packetRing;
+
+// Packets read from the network, per protocol, since the last stats print
+struct ProtocolCounters {
+  unsigned long packets;
+  unsigned long bytes;
+  unsigned long rejects;
+  unsigned long filtered;
+
+  template <class S> void add(const S &stats) {
+    packets += stats.packets;
+    bytes += stats.bytes;
+    rejects += stats.rejects;
+    filtered += stats.filtered;
+  }
+};
+ProtocolCounters artnetCounters, sacnCounters;
+
+/**
+ * @brief Receive the next packet of either protocol in the next free slot.
+ */
+void reservePacket() {
+  uint8_t *slot = packetRing.reserve();
+  artnet.setPacketBuffer(slot);
+  e131.setDataBuffer(slot ? slot + ART_DMX_START : nullptr);
+}
 
 #include "LEDController.h"
 LEDController::CTeensy4Controller *pcontroller;
@@ -141,45 +304,149 @@ LEDController *ledController;
  * @brief Initialize the LED controller.
  */
 void initializeLEDController() {
+#if LED_BACKEND == LED_BACKEND_OBJECTFLED
+  // begin(LED_CLK_nS, LED_T0H_nS, LED_T1H_nS, LED_Latch_Delay_uS)
+  fled.begin(1250, 300, 600, 80);
+  DEBUG_INFO("fled.begin\n");
+#elif LED_BACKEND == LED_BACKEND_TDWS2811
+  if (!tdws.begin(TDWS28XX::FLEXIO1, tdwsPins))
+    DEBUG_ERROR("ERROR: TDWS2811 begin failed\n");
+  DEBUG_INFO("tdws.begin\n");
+  // Load the blank frame once: a strip the driver rejects shows up here
+  tdwsOutput.prepare(tdwsOutput.getDrawBuffer());
+  if (tdwsOutput.hasSpanError())
+    DEBUG_ERROR("ERROR: strips do not fit the TDWS2811 buffer\n");
+#elif LED_BACKEND == LED_BACKEND_MEMORY
+  DEBUG_INFO("memory output, %lu us per frame\n",
+                (unsigned long)outputMicros);
+#else
+  octo.setStripLengths(stripLengths);
   octo.begin();
-  Debug::println("octo.begin");
-  ledController = new LEDController(&octo);
-  pcontroller = new LEDController::CTeensy4Controller(&octo, *ledController);
+  DEBUG_INFO("octo.begin\n");
+  if (fullframe_set == 1 && !octo.setBitBuffer(bitBuffer))
+    DEBUG_ERROR("ERROR: strips too long for the full frame DMA\n");
+  // Rotate the buffers in show() instead of copying them
+  octo.setBuffers(true, spareMemory);
+#endif
+  const OutputCapabilities &caps = output->capabilities();
+  DEBUG_INFO("output = %s\n", caps.name);
+  if (numStrips > caps.maxStrips)
+    DEBUG_ERROR("ERROR: too many strips for this output\n");
+  if (!caps.raggedStrips && numLeds != ledsPerStrip * numStrips)
+    DEBUG_ERROR("ERROR: this output needs strips of the same length\n");
+  ledController = new LEDController(output);
+  ledController->setLeds(rgbarray, numLeds);
+  ledController->setUniverses(startUniverse, maxUniverses, pixelsPerUniverse);
+  ledController->setPacketRing(&packetRing);
+  pcontroller = new LEDController::CTeensy4Controller(output, *ledController);
+  ledController->setBackBuffer(rgbback, pcontroller);
+  ledController->setDecodeBuffer(pixelReference);
+  ledController->setArtSync(artsync_set == 1, ARTSYNC_TIMEOUT_MS);
+  ledController->setColorOrder(caps.colorOrder);
+  ledController->setGammaCurves(gamma_set == 1);
+  // Artnet data is written straight into drawingMemory
+  ledController->setDirectOutput(true);
+  ledController->setBrightness(BRIGHTNESS);
+  ledController->setColorBalance((COLOR_CORRECTION >> 16) & 0xFF,
+                                 (COLOR_CORRECTION >> 8) & 0xFF,
+                                 COLOR_CORRECTION & 0xFF);
+  if (power_set == 1) {
+    PowerBudget &power = ledController->getPowerBudget();
+    if (!power.setGroups(powerGroup, stripLengths, numPins))
+      DEBUG_ERROR("ERROR: too many power injection groups\n");
+    power.setChannelCurrent(LED_CHANNEL_MA[0], LED_CHANNEL_MA[1],
+                            LED_CHANNEL_MA[2], LED_CHANNEL_MA[3], LED_IDLE_UA);
+    for (int g = 0; g < numPowerGroups; g++)
+      if (!power.setBudget(g, POWER_GROUP_BUDGET_MA))
+        DEBUG_ERROR("ERROR: power group %d idles at %lu mA, over its budget\n",
+                    g, (unsigned long)power.idleCurrent(g));
+  }
   FastLED.setBrightness(BRIGHTNESS);
-  FastLED.addLeds(pcontroller, rgbarray, numPins * ledsPerStrip)
+  FastLED.addLeds(pcontroller, rgbarray, numLeds)
       .setCorrection(COLOR_CORRECTION);
   FastLED.delay(10000 / FRAMES_PER_SECOND);
-  Debug::println("init test");
-  Debug::println("________________INIT TEST_________________");
+  DEBUG_INFO("init test\n");
+  DEBUG_INFO("________________INIT TEST_________________\n");
   FastLED.setBrightness(20);
-  ledController = new LEDController(&octo);
   ledController->initTest();
-  Debug::println("________________END INIT TEST_________________");
+  DEBUG_INFO("________________END INIT TEST_________________\n");
   FastLED.setBrightness(BRIGHTNESS);
 }
 
 /**
- * @brief Initialize the Artnet settings.
+ * @brief Initialize the Artnet and sACN settings.
  */
 void initializeArtnet() {
-  if (artnet_set == 1) {
+  if (artnet_set == 1 || sacn_set == 1) {
     uint8_t mac[6];
     TeensyID::getMAC(mac);
     Ethernet.setSubnetMask({255, 255, 0, 0});
-    Debug::printf("IP = %d.%d.%d.%0d\n", ip[0], ip[1], ip[2], ip[3]);
-    artnet.begin(mac, ip);
-    Debug::println("artnet.begin");
+    // one socket per sACN universe, and the Art-Net one
+    if (sacn_set == 1)
+      Ethernet.setSocketNum(maxUniverses + 2);
+    DEBUG_INFO("IP = %d.%d.%d.%0d\n", ip[0], ip[1], ip[2], ip[3]);
+    if (artnet_set == 1) {
+      // ArtPollReply pages, built once here: a poll only sends them
+      char shortName[18];
+      snprintf(shortName, sizeof(shortName), "Etendard %d", ip[3]);
+      artnet.setNodeName(shortName, "KXKM Etendard - Teensy OctoWS28 Artnet Node");
+      artnet.setOutputUniverses(startUniverse, maxUniverses);
+      artnet.begin(mac, ip);
+      // ArtDmx of the other etendards are dropped after their header
+      artnet.setUniverseFilter(startUniverse, maxUniverses);
+      DEBUG_INFO("artnet.begin\n");
+    } else {
+      Ethernet.begin(mac, ip);
+    }
   } else {
-    Debug::println("Artnet not set");
+    DEBUG_INFO("Artnet not set\n");
   }
 
+  // Only queue the packet here, the render stage assembles the frames.
+  // Packets are received straight into the next free slot of the ring.
+  reservePacket();
   artnet.setArtDmxCallback([](uint16_t universe, uint16_t length,
                               uint8_t sequence, uint8_t *data,
                               IPAddress remoteIP) {
-    ledController->onDmxFrameFull(universe, length, sequence, data);
+    packetRing.push(universe, length, sequence, data);
+    reservePacket();
+  });
+  // Frames of video2artnet.py in ART_PIXEL packets, up to 484 pixels each
+  artnet.setArtPixelCallback([](uint16_t frame, uint16_t firstPixel,
+                                uint16_t length, uint8_t sequence,
+                                uint8_t flags, uint8_t *data,
+                                IPAddress remoteIP) {
+    packetRing.pushPixels(frame, firstPixel, length, sequence, flags, data);
+    reservePacket();
   });
+  // the sync takes the reserved slot too: the next packet needs a new one
+  artnet.setArtSyncCallback([](IPAddress remoteIP) {
+    packetRing.pushSync();
+    reservePacket();
+  });
+  DEBUG_INFO("artnet.setArtDmxCallback\n");
 
-  Debug::println("artnet.setArtDmxCallback");
+  if (sacn_set == 1) {
+    uint16_t joined = e131.begin(sacnFirstUniverse, maxUniverses);
+    DEBUG_INFO("sACN universes %d to %d\n", sacnFirstUniverse,
+               sacnFirstUniverse + joined - 1);
+    // the universes after the last group joined never arrive
+    if (joined < maxUniverses)
+      DEBUG_ERROR("ERROR: joined %u of %d sACN multicast groups, universe %d "
+                  "failed (sockets or memberships exhausted)\n",
+                  joined, maxUniverses, sacnFirstUniverse + joined);
+    e131.setDataCallback([](uint16_t universe, uint16_t length,
+                            uint8_t sequence, uint8_t *data,
+                            IPAddress remoteIP) {
+      packetRing.push(universe - sacnFirstUniverse + startUniverse, length,
+                      sequence, data);
+      reservePacket();
+    });
+    e131.setSyncCallback([](IPAddress remoteIP) {
+      packetRing.pushSync();
+      reservePacket();
+    });
+  }
 }
 
 /**
@@ -188,9 +455,9 @@ void initializeArtnet() {
 void setup() {
   if (debug_set)
     Debug::enable();
-  Debug::println("KXKM Etendard");
-  Debug::println("Teensy OctoWS28 Artnet Node");
-  Debug::println("=================");
+  DEBUG_INFO("KXKM Etendard\n");
+  DEBUG_INFO("Teensy OctoWS28 Artnet Node\n");
+  DEBUG_INFO("=================\n");
 
   TeensyID::initializeEEPROM(ip);
   initializeLEDController();
@@ -207,8 +474,36 @@ void setup() {
  */
 void loop() {
   // we call the read function inside the loop
-  if (artnet_set == 1) {
-    artnet.read();
+  if (artnet_set == 1 || sacn_set == 1) {
+    // read every pending packet the ring can hold, then render
+    uint16_t room = PACKET_RING_SIZE - packetRing.size();
+    if (artnet_set == 1 && room) {
+      reservePacket();
+      artnetCounters.add(artnet.readAll(room, ARTNET_READ_BUDGET_US));
+    }
+    room = PACKET_RING_SIZE - packetRing.size();
+    if (sacn_set == 1 && room) {
+      reservePacket();
+      sacnCounters.add(e131.readAll(room, ARTNET_READ_BUDGET_US));
+    }
+    ledController->render();
+    // nothing left to render: print the events logged since the last loop
+    if (!packetRing.size())
+      DEBUG_FLUSH();
+
+    static unsigned long lastStats = 0;
+    if (STATS_INTERVAL_MS && millis() - lastStats > STATS_INTERVAL_MS) {
+      lastStats = millis();
+      ledController->printStats();
+      DEBUG_INFO("artnet packets = %lu\tfiltered = %lu\tbytes = %lu\t"
+                 "rejects = %lu\tsacn packets = %lu\tfiltered = %lu\t"
+                 "bytes = %lu\trejects = %lu\n",
+                 artnetCounters.packets, artnetCounters.filtered,
+                 artnetCounters.bytes, artnetCounters.rejects,
+                 sacnCounters.packets, sacnCounters.filtered,
+                 sacnCounters.bytes, sacnCounters.rejects);
+      artnetCounters = sacnCounters = ProtocolCounters();
+    }
   } else {
     delay(1000);
     ledController->initTest();
@@ -0,0 +1,108 @@
+// Teensy OctoWS28 Artnet Node - ART_PIXEL_RLE encoder
+// =================
+// Version: V0.2.1
+//
+// Same coding as Video2Artnet/pixelcodec.py, to feed the decode benchmark
+// with packets without the network: codes of up to 64 pixels, SKIP for the
+// pixels unchanged since the previous frame, RUN for repeated pixels, COPY
+// for the rest (see src/PixelDecoder.h).
+
+#ifndef PIXELENCODER_H
+#define PIXELENCODER_H
+
+#include <Arduino.h>
+
+#include "../../src/PixelDecoder.h"
+
+struct EncodedPacket {
+  uint16_t firstPixel;
+  uint16_t pixelCount;
+  uint16_t length;
+  uint8_t data[ART_PIXEL_MAX_LENGTH];
+};
+
+class PixelEncoder {
+public:
+  // Code count pixels of frame against previous (nullptr for a key frame)
+  // into at most maxPackets packets. Return the number of packets, 0 if they
+  // do not fit.
+  static uint16_t encode(const uint8_t *frame, const uint8_t *previous,
+                         uint16_t count, EncodedPacket *packets,
+                         uint16_t maxPackets) {
+    uint16_t numPackets = 0;
+    EncodedPacket *packet = nullptr;
+    uint16_t i = 0;
+    while (i < count) {
+      if (!packet) {
+        if (numPackets == maxPackets)
+          return 0;
+        packet = &packets[numPackets++];
+        packet->firstPixel = i;
+        packet->length = 2;
+      }
+
+      uint8_t code[1 + PIXEL_CODE_MAX_PIXELS * 3];
+      uint16_t codeLength;
+      uint16_t n;
+      if (unchanged(frame, previous, i)) {
+        n = 1;
+        while (i + n < count && n < PIXEL_CODE_MAX_PIXELS &&
+               unchanged(frame, previous, i + n))
+          n++;
+        code[0] = PIXEL_CODE_SKIP | (n - 1);
+        codeLength = 1;
+      } else if (repeated(frame, count, i)) {
+        n = 2;
+        while (i + n < count && n < PIXEL_CODE_MAX_PIXELS &&
+               !memcmp(frame + (i + n) * 3, frame + i * 3, 3))
+          n++;
+        code[0] = PIXEL_CODE_RUN | (n - 1);
+        memcpy(code + 1, frame + i * 3, 3);
+        codeLength = 4;
+      } else {
+        n = 1;
+        while (i + n < count && n < PIXEL_CODE_MAX_PIXELS &&
+               !unchanged(frame, previous, i + n) &&
+               !repeated(frame, count, i + n))
+          n++;
+        // fill the packet up with the first pixels of the copy
+        int room = (ART_PIXEL_MAX_LENGTH - packet->length - 1) / 3;
+        if (room >= 1 && n > room)
+          n = room;
+        code[0] = PIXEL_CODE_COPY | (n - 1);
+        memcpy(code + 1, frame + i * 3, n * 3);
+        codeLength = 1 + n * 3;
+      }
+
+      if (packet->length + codeLength > ART_PIXEL_MAX_LENGTH) {
+        finish(packet, i);
+        packet = nullptr;
+        continue;
+      }
+      memcpy(packet->data + packet->length, code, codeLength);
+      packet->length += codeLength;
+      i += n;
+    }
+    if (packet)
+      finish(packet, count);
+    return numPackets;
+  }
+
+private:
+  static bool unchanged(const uint8_t *frame, const uint8_t *previous,
+                        uint16_t i) {
+    return previous && !memcmp(frame + i * 3, previous + i * 3, 3);
+  }
+
+  static bool repeated(const uint8_t *frame, uint16_t count, uint16_t i) {
+    return i + 1 < count && !memcmp(frame + (i + 1) * 3, frame + i * 3, 3);
+  }
+
+  static void finish(EncodedPacket *packet, uint16_t end) {
+    packet->pixelCount = end - packet->firstPixel;
+    packet->data[0] = packet->pixelCount & 0xFF;
+    packet->data[1] = packet->pixelCount >> 8;
+  }
+};
+
+#endif // PIXELENCODER_H
@@ -0,0 +1,174 @@
+// Generated by make_fixture.py from Video2Artnet/pixelcodec.py, do not edit
+
+#ifndef PIXELCODECFIXTURE_H
+#define PIXELCODECFIXTURE_H
+
+#include <Arduino.h>
+
+struct FixturePacket {
+  uint16_t firstPixel;
+  uint16_t pixelCount;
+  uint16_t length;
+  const uint8_t *data;
+};
+
+const uint16_t fixtureNumLeds = 300;
+const uint8_t fixtureKeyFrame[900] = {
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0xbc, 0x14, 0x64, 0xc3,
+    0x21, 0x65, 0xca, 0x2e, 0x66, 0xd1, 0x3b, 0x67, 0xd8, 0x48, 0x68, 0xdf, 0x55, 0x69, 0xe6, 0x62,
+    0x6a, 0xed, 0x6f, 0x6b, 0xf4, 0x7c, 0x6c, 0xfb, 0x89, 0x6d, 0x02, 0x96, 0x6e, 0x09, 0xa3, 0x6f,
+    0x10, 0xb0, 0x70, 0x17, 0xbd, 0x71, 0x1e, 0xca, 0x72, 0x25, 0xd7, 0x73, 0x2c, 0xe4, 0x74, 0x33,
+    0xf1, 0x75, 0x3a, 0xfe, 0x76, 0x41, 0x0b, 0x77, 0x48, 0x18, 0x78, 0x4f, 0x25, 0x79, 0x56, 0x32,
+    0x7a, 0x5d, 0x3f, 0x7b, 0x64, 0x4c, 0x7c, 0x6b, 0x59, 0x7d, 0x72, 0x66, 0x7e, 0x79, 0x73, 0x7f,
+    0x80, 0x80, 0x80, 0x87, 0x8d, 0x81, 0x8e, 0x9a, 0x82, 0x95, 0xa7, 0x83, 0x9c, 0xb4, 0x84, 0xa3,
+    0xc1, 0x85, 0xaa, 0xce, 0x86, 0xb1, 0xdb, 0x87, 0xb8, 0xe8, 0x88, 0xbf, 0xf5, 0x89, 0xc6, 0x02,
+    0x8a, 0xcd, 0x0f, 0x8b, 0xd4, 0x1c, 0x8c, 0xdb, 0x29, 0x8d, 0xe2, 0x36, 0x8e, 0xe9, 0x43, 0x8f,
+    0xf0, 0x50, 0x90, 0xf7, 0x5d, 0x91, 0xfe, 0x6a, 0x92, 0x05, 0x77, 0x93, 0x0c, 0x84, 0x94, 0x13,
+    0x91, 0x95, 0x1a, 0x9e, 0x96, 0x21, 0xab, 0x97, 0x28, 0xb8, 0x98, 0x2f, 0xc5, 0x99, 0x36, 0xd2,
+    0x9a, 0x3d, 0xdf, 0x9b, 0x44, 0xec, 0x9c, 0x4b, 0xf9, 0x9d, 0x52, 0x06, 0x9e, 0x59, 0x13, 0x9f,
+    0x60, 0x20, 0xa0, 0x67, 0x2d, 0xa1, 0x6e, 0x3a, 0xa2, 0x75, 0x47, 0xa3, 0x7c, 0x54, 0xa4, 0x83,
+    0x61, 0xa5, 0x8a, 0x6e, 0xa6, 0x91, 0x7b, 0xa7, 0x98, 0x88, 0xa8, 0x9f, 0x95, 0xa9, 0xa6, 0xa2,
+    0xaa, 0xad, 0xaf, 0xab, 0xb4, 0xbc, 0xac, 0xbb, 0xc9, 0xad, 0xc2, 0xd6, 0xae, 0xc9, 0xe3, 0xaf,
+    0xd0, 0xf0, 0xb0, 0xd7, 0xfd, 0xb1, 0xde, 0x0a, 0xb2, 0xe5, 0x17, 0xb3, 0xec, 0x24, 0xb4, 0xf3,
+    0x31, 0xb5, 0xfa, 0x3e, 0xb6, 0x01, 0x4b, 0xb7, 0x08, 0x58, 0xb8, 0x0f, 0x65, 0xb9, 0x16, 0x72,
+    0xba, 0x1d, 0x7f, 0xbb, 0x24, 0x8c, 0xbc, 0x2b, 0x99, 0xbd, 0x32, 0xa6, 0xbe, 0x39, 0xb3, 0xbf,
+    0x40, 0xc0, 0xc0, 0x47, 0xcd, 0xc1, 0x4e, 0xda, 0xc2, 0x55, 0xe7, 0xc3, 0x5c, 0xf4, 0xc4, 0x63,
+    0x01, 0xc5, 0x6a, 0x0e, 0xc6, 0x71, 0x1b, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+};
+const uint8_t fixtureDeltaFrame[900] = {
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a,
+    0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14,
+    0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e,
+    0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0x0a, 0x14, 0x1e, 0xbc, 0x14, 0x64, 0xc3,
+    0x21, 0x65, 0xca, 0x2e, 0x66, 0xd1, 0x3b, 0x67, 0xd8, 0x48, 0x68, 0xdf, 0x55, 0x69, 0xe6, 0x62,
+    0x6a, 0xed, 0x6f, 0x6b, 0xf4, 0x7c, 0x6c, 0xfb, 0x89, 0x6d, 0x02, 0x96, 0x6e, 0x09, 0xa3, 0x6f,
+    0x10, 0xb0, 0x70, 0x17, 0xbd, 0x71, 0x1e, 0xca, 0x72, 0x25, 0xd7, 0x73, 0x2c, 0xe4, 0x74, 0x33,
+    0xf1, 0x75, 0x3a, 0xfe, 0x76, 0x41, 0x0b, 0x77, 0xb7, 0x18, 0x78, 0xb0, 0x25, 0x79, 0xa9, 0x32,
+    0x7a, 0xa2, 0x3f, 0x7b, 0x9b, 0x4c, 0x7c, 0x94, 0x59, 0x7d, 0x8d, 0x66, 0x7e, 0x86, 0x73, 0x7f,
+    0x7f, 0x80, 0x80, 0x78, 0x8d, 0x81, 0x71, 0x9a, 0x82, 0x6a, 0xa7, 0x83, 0x63, 0xb4, 0x84, 0x5c,
+    0xc1, 0x85, 0x55, 0xce, 0x86, 0x4e, 0xdb, 0x87, 0x47, 0xe8, 0x88, 0x40, 0xf5, 0x89, 0x39, 0x02,
+    0x8a, 0x32, 0x0f, 0x8b, 0xd4, 0x1c, 0x8c, 0xdb, 0x29, 0x8d, 0xe2, 0x36, 0x8e, 0xe9, 0x43, 0x8f,
+    0xf0, 0x50, 0x90, 0xf7, 0x5d, 0x91, 0xfe, 0x6a, 0x92, 0x05, 0x77, 0x93, 0x0c, 0x84, 0x94, 0x13,
+    0x91, 0x95, 0x1a, 0x9e, 0x96, 0x21, 0xab, 0x97, 0x28, 0xb8, 0x98, 0x2f, 0xc5, 0x99, 0x36, 0xd2,
+    0x9a, 0x3d, 0xdf, 0x9b, 0x44, 0xec, 0x9c, 0x4b, 0xf9, 0x9d, 0x52, 0x06, 0x9e, 0x59, 0x13, 0x9f,
+    0x60, 0x20, 0xa0, 0x67, 0x2d, 0xa1, 0x6e, 0x3a, 0xa2, 0x75, 0x47, 0xa3, 0x7c, 0x54, 0xa4, 0x83,
+    0x61, 0xa5, 0x8a, 0x6e, 0xa6, 0x91, 0x7b, 0xa7, 0x98, 0x88, 0xa8, 0x9f, 0x95, 0xa9, 0xa6, 0xa2,
+    0xaa, 0xad, 0xaf, 0xab, 0xb4, 0xbc, 0xac, 0xbb, 0xc9, 0xad, 0xc2, 0xd6, 0xae, 0xc9, 0xe3, 0xaf,
+    0xd0, 0xf0, 0xb0, 0xd7, 0xfd, 0xb1, 0xde, 0x0a, 0xb2, 0xe5, 0x17, 0xb3, 0xec, 0x24, 0xb4, 0xf3,
+    0x31, 0xb5, 0xfa, 0x3e, 0xb6, 0x01, 0x4b, 0xb7, 0x08, 0x58, 0xb8, 0x0f, 0x65, 0xb9, 0x16, 0x72,
+    0xba, 0x1d, 0x7f, 0xbb, 0x24, 0x8c, 0xbc, 0x2b, 0x99, 0xbd, 0x32, 0xa6, 0xbe, 0x39, 0xb3, 0xbf,
+    0x40, 0xc0, 0xc0, 0x47, 0xcd, 0xc1, 0x4e, 0xda, 0xc2, 0x55, 0xe7, 0xc3, 0x5c, 0xf4, 0xc4, 0x63,
+    0x01, 0xc5, 0x6a, 0x0e, 0xc6, 0x71, 0x1b, 0xc7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc8, 0x64,
+    0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32,
+    0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8,
+    0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64,
+    0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32,
+    0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8,
+    0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64,
+    0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32,
+    0xc8, 0x64, 0x32, 0xc8, 0x64, 0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+};
+const uint8_t fixtureKeyPackets0Data[200] = {
+    0xa3, 0x00, 0x7f, 0x0a, 0x14, 0x1e, 0x63, 0x0a, 0x14, 0x1e, 0x3e, 0xbc, 0x14, 0x64, 0xc3, 0x21,
+    0x65, 0xca, 0x2e, 0x66, 0xd1, 0x3b, 0x67, 0xd8, 0x48, 0x68, 0xdf, 0x55, 0x69, 0xe6, 0x62, 0x6a,
+    0xed, 0x6f, 0x6b, 0xf4, 0x7c, 0x6c, 0xfb, 0x89, 0x6d, 0x02, 0x96, 0x6e, 0x09, 0xa3, 0x6f, 0x10,
+    0xb0, 0x70, 0x17, 0xbd, 0x71, 0x1e, 0xca, 0x72, 0x25, 0xd7, 0x73, 0x2c, 0xe4, 0x74, 0x33, 0xf1,
+    0x75, 0x3a, 0xfe, 0x76, 0x41, 0x0b, 0x77, 0x48, 0x18, 0x78, 0x4f, 0x25, 0x79, 0x56, 0x32, 0x7a,
+    0x5d, 0x3f, 0x7b, 0x64, 0x4c, 0x7c, 0x6b, 0x59, 0x7d, 0x72, 0x66, 0x7e, 0x79, 0x73, 0x7f, 0x80,
+    0x80, 0x80, 0x87, 0x8d, 0x81, 0x8e, 0x9a, 0x82, 0x95, 0xa7, 0x83, 0x9c, 0xb4, 0x84, 0xa3, 0xc1,
+    0x85, 0xaa, 0xce, 0x86, 0xb1, 0xdb, 0x87, 0xb8, 0xe8, 0x88, 0xbf, 0xf5, 0x89, 0xc6, 0x02, 0x8a,
+    0xcd, 0x0f, 0x8b, 0xd4, 0x1c, 0x8c, 0xdb, 0x29, 0x8d, 0xe2, 0x36, 0x8e, 0xe9, 0x43, 0x8f, 0xf0,
+    0x50, 0x90, 0xf7, 0x5d, 0x91, 0xfe, 0x6a, 0x92, 0x05, 0x77, 0x93, 0x0c, 0x84, 0x94, 0x13, 0x91,
+    0x95, 0x1a, 0x9e, 0x96, 0x21, 0xab, 0x97, 0x28, 0xb8, 0x98, 0x2f, 0xc5, 0x99, 0x36, 0xd2, 0x9a,
+    0x3d, 0xdf, 0x9b, 0x44, 0xec, 0x9c, 0x4b, 0xf9, 0x9d, 0x52, 0x06, 0x9e, 0x59, 0x13, 0x9f, 0x60,
+    0x20, 0xa0, 0x67, 0x2d, 0xa1, 0x6e, 0x3a, 0xa2,
+};
+const uint8_t fixtureKeyPackets1Data[122] = {
+    0x89, 0x00, 0x24, 0x75, 0x47, 0xa3, 0x7c, 0x54, 0xa4, 0x83, 0x61, 0xa5, 0x8a, 0x6e, 0xa6, 0x91,
+    0x7b, 0xa7, 0x98, 0x88, 0xa8, 0x9f, 0x95, 0xa9, 0xa6, 0xa2, 0xaa, 0xad, 0xaf, 0xab, 0xb4, 0xbc,
+    0xac, 0xbb, 0xc9, 0xad, 0xc2, 0xd6, 0xae, 0xc9, 0xe3, 0xaf, 0xd0, 0xf0, 0xb0, 0xd7, 0xfd, 0xb1,
+    0xde, 0x0a, 0xb2, 0xe5, 0x17, 0xb3, 0xec, 0x24, 0xb4, 0xf3, 0x31, 0xb5, 0xfa, 0x3e, 0xb6, 0x01,
+    0x4b, 0xb7, 0x08, 0x58, 0xb8, 0x0f, 0x65, 0xb9, 0x16, 0x72, 0xba, 0x1d, 0x7f, 0xbb, 0x24, 0x8c,
+    0xbc, 0x2b, 0x99, 0xbd, 0x32, 0xa6, 0xbe, 0x39, 0xb3, 0xbf, 0x40, 0xc0, 0xc0, 0x47, 0xcd, 0xc1,
+    0x4e, 0xda, 0xc2, 0x55, 0xe7, 0xc3, 0x5c, 0xf4, 0xc4, 0x63, 0x01, 0xc5, 0x6a, 0x0e, 0xc6, 0x71,
+    0x1b, 0xc7, 0x7f, 0x00, 0x00, 0x00, 0x63, 0x00, 0x00, 0x00,
+};
+const FixturePacket fixtureKeyPackets[] = {
+    {0, 163, 200, fixtureKeyPackets0Data},
+    {163, 137, 122, fixtureKeyPackets1Data},
+};
+const uint8_t fixtureDeltaPackets0Data[72] = {
+    0x2c, 0x01, 0xbf, 0xb7, 0x13, 0xb7, 0x18, 0x78, 0xb0, 0x25, 0x79, 0xa9, 0x32, 0x7a, 0xa2, 0x3f,
+    0x7b, 0x9b, 0x4c, 0x7c, 0x94, 0x59, 0x7d, 0x8d, 0x66, 0x7e, 0x86, 0x73, 0x7f, 0x7f, 0x80, 0x80,
+    0x78, 0x8d, 0x81, 0x71, 0x9a, 0x82, 0x6a, 0xa7, 0x83, 0x63, 0xb4, 0x84, 0x5c, 0xc1, 0x85, 0x55,
+    0xce, 0x86, 0x4e, 0xdb, 0x87, 0x47, 0xe8, 0x88, 0x40, 0xf5, 0x89, 0x39, 0x02, 0x8a, 0x32, 0x0f,
+    0x8b, 0xbf, 0xad, 0x67, 0xc8, 0x64, 0x32, 0x89,
+};
+const FixturePacket fixtureDeltaPackets[] = {
+    {0, 300, 72, fixtureDeltaPackets0Data},
+};
+
+#endif // PIXELCODECFIXTURE_H
@@ -0,0 +1,212 @@
+// Teensy OctoWS28 Artnet Node - compressed frame decode benchmark
+// =================
+// Version: V0.2.1
+//
+// Codes a synthetic slow video on the Etendard V2.a layout (36 pins x 138
+// LEDs: flat background, a soft blob drifting across the middle) into
+// ART_PIXEL_RLE packets, a key frame every KEYFRAME_INTERVAL frames and
+// delta frames in between, then times PixelDecoder::decode() of the packets
+// of each frame. Prints min / median / p99 / max per frame as CSV lines (see
+// ../bench_hotpaths/BenchStats.h), in CPU cycles on the Teensy and ns on the
+// host:
+//  - decode_key   : packets of a key frame
+//  - decode_delta : packets of a delta frame
+//  - copy_plain   : the same frame in uncompressed ART_PIXEL packets, copied
+//                   into the reference frame (what decoding replaces)
+// followed by the bytes sent per frame and the curtains one 100 Mbit segment
+// carries at FRAMES_PER_SECOND. Every decoded frame is checked against the
+// source frame. First, packets coded by Video2Artnet/pixelcodec.py (the
+// sender, PixelcodecFixture.h written by make_fixture.py) are decoded and
+// checked, so that the sender and the node agree on the format.
+//
+// pio run -e etendarv2a_bench_decode -t upload && pio device monitor
+// pio run -e native_bench_decode && .pio/build/native_bench_decode/program
+
+#include <Artnet.h>
+#include <math.h>
+
+#include "../../src/PixelDecoder.h"
+#include "../bench_hotpaths/BenchStats.h"
+#include "PixelEncoder.h"
+#include "PixelcodecFixture.h"
+
+const int numPins = 36;
+const int ledsPerStrip = 138;
+const int numLeds = ledsPerStrip * numPins;
+const int FRAMES = 250;
+const int KEYFRAME_INTERVAL = 25;
+const int FRAMES_PER_SECOND = 40;
+// Ethernet, IP and UDP bytes of a datagram: preamble, header, FCS, gap
+const int WIRE_OVERHEAD = 8 + 14 + 4 + 12 + 20 + 8;
+const int MAX_PACKETS = 16;
+// Pixels of an uncompressed ART_PIXEL packet
+const int PLAIN_PIXELS = ART_PIXEL_MAX_LENGTH / 3;
+
+uint8_t frame[numLeds * 3];
+uint8_t previous[numLeds * 3];
+uint8_t reference[numLeds * 3];
+EncodedPacket packets[MAX_PACKETS];
+
+PixelDecoder decoder;
+
+BenchStats keyStats("decode_key");
+BenchStats deltaStats("decode_delta");
+BenchStats plainStats("copy_plain");
+
+// Set by checkFixture(), the bench fails with it
+bool fixtureFailed = false;
+
+// Source frame f: pixels of a pin follow each other, as on the curtain
+void drawFrame(int f) {
+  float bx = 18 + 12 * sinf(f / 60.0f);
+  float by = 69 + 30 * cosf(f / 80.0f);
+  for (int x = 0; x < numPins; x++) {
+    for (int y = 0; y < ledsPerStrip; y++) {
+      uint8_t *p = frame + (x * ledsPerStrip + y) * 3;
+      float d2 = (x - bx) * (x - bx) + (y - by) * (y - by);
+      if (d2 < 400) {
+        // video is quantized: small moves leave most pixels unchanged
+        uint8_t v = (uint8_t)(255 * (1 - d2 / 400)) & 0xF0;
+        p[0] = v;
+        p[1] = v / 2;
+        p[2] = 255 - v;
+      } else {
+        p[0] = 0;
+        p[1] = 0;
+        p[2] = y < ledsPerStrip / 3 ? 64 : 0;
+      }
+    }
+  }
+}
+
+// Decode the packets of a pixelcodec.py frame and compare with its source
+bool decodeFixture(PixelDecoder &fixtureDecoder, uint8_t *fixtureReference,
+                   const FixturePacket *fixturePackets, int count,
+                   uint8_t flags, const uint8_t *source) {
+  for (int i = 0; i < count; i++) {
+    const FixturePacket &p = fixturePackets[i];
+    if (PixelDecoder::pixelCount(p.data, p.length) != p.pixelCount ||
+        !fixtureDecoder.decode(p.data, p.length, flags, p.firstPixel))
+      return false;
+  }
+  return !memcmp(fixtureReference, source, fixtureNumLeds * 3);
+}
+
+void checkFixture() {
+  static uint8_t fixtureReference[fixtureNumLeds * 3];
+  PixelDecoder fixtureDecoder;
+  fixtureDecoder.begin(fixtureReference, fixtureNumLeds);
+  bool key = decodeFixture(
+      fixtureDecoder, fixtureReference, fixtureKeyPackets,
+      sizeof(fixtureKeyPackets) / sizeof(fixtureKeyPackets[0]), ART_PIXEL_RLE,
+      fixtureKeyFrame);
+  bool delta = decodeFixture(
+      fixtureDecoder, fixtureReference, fixtureDeltaPackets,
+      sizeof(fixtureDeltaPackets) / sizeof(fixtureDeltaPackets[0]),
+      ART_PIXEL_RLE | ART_PIXEL_DELTA, fixtureDeltaFrame);
+  fixtureFailed = !key || !delta;
+}
+
+unsigned long wireBytes(uint32_t payload, uint16_t numPackets) {
+  return payload + numPackets * (ART_DMX_START + WIRE_OVERHEAD);
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial && millis() < 3000) {
+  }
+  BenchStats::begin();
+  checkFixture();
+  decoder.begin(reference, numLeds);
+}
+
+void loop() {
+  BenchStats *stats[] = {&keyStats, &deltaStats, &plainStats};
+  for (BenchStats *s : stats)
+    s->reset();
+
+  unsigned long keyBytes = 0, deltaBytes = 0;
+  int keyFrames = 0, deltaFrames = 0, errors = 0;
+  const uint16_t plainPackets = (numLeds + PLAIN_PIXELS - 1) / PLAIN_PIXELS;
+
+  for (int f = 0; f < FRAMES; f++) {
+    drawFrame(f);
+    bool key = f % KEYFRAME_INTERVAL == 0;
+    uint8_t flags = ART_PIXEL_RLE | (key ? 0 : ART_PIXEL_DELTA);
+    uint16_t numPackets = PixelEncoder::encode(
+        frame, key ? nullptr : previous, numLeds, packets, MAX_PACKETS);
+    if (!numPackets) {
+      Serial.println("ERROR: frame does not fit in MAX_PACKETS");
+      errors++;
+      continue;
+    }
+
+    BenchStats &s = key ? keyStats : deltaStats;
+    s.enter();
+    for (uint16_t i = 0; i < numPackets; i++)
+      decoder.decode(packets[i].data, packets[i].length, flags,
+                     packets[i].firstPixel);
+    s.add(s.leave());
+    decoder.setReference(f);
+
+    uint32_t payload = 0;
+    for (uint16_t i = 0; i < numPackets; i++)
+      payload += packets[i].length;
+    if (key) {
+      keyBytes += wireBytes(payload, numPackets);
+      keyFrames++;
+    } else {
+      deltaBytes += wireBytes(payload, numPackets);
+      deltaFrames++;
+    }
+    if (memcmp(reference, frame, sizeof(frame)))
+      errors++;
+
+    plainStats.enter();
+    for (uint16_t i = 0; i < plainPackets; i++) {
+      uint16_t first = i * PLAIN_PIXELS;
+      uint16_t count =
+          numLeds - first < PLAIN_PIXELS ? numLeds - first : PLAIN_PIXELS;
+      memcpy(reference + first * 3, frame + first * 3, count * 3);
+    }
+    plainStats.add(plainStats.leave());
+
+    memcpy(previous, frame, sizeof(frame));
+  }
+
+  Serial.printf("# decode %s, %d LEDs, %d frames, key frame every %d\n",
+#ifdef NATIVE_HOST
+                "host",
+#else
+                "teensy41 600 MHz",
+#endif
+                numLeds, FRAMES, KEYFRAME_INTERVAL);
+  BenchStats::printHeader();
+  for (BenchStats *s : stats)
+    s->print();
+
+  unsigned long plain = wireBytes(numLeds * 3, plainPackets);
+  unsigned long coded = (keyBytes + deltaBytes) / (keyFrames + deltaFrames);
+  Serial.printf("# bytes per frame on the wire: plain %lu, key %lu, "
+                "delta %lu, average %lu\n",
+                plain, keyFrames ? keyBytes / keyFrames : 0UL,
+                deltaFrames ? deltaBytes / deltaFrames : 0UL, coded);
+  Serial.printf("# curtains per 100 Mbit at %d fps: plain %lu, coded %lu\n",
+                FRAMES_PER_SECOND,
+                100000000UL / (plain * 8 * FRAMES_PER_SECOND),
+                100000000UL / (coded * 8 * FRAMES_PER_SECOND));
+  const PixelDecoderStats &ds = decoder.getStats();
+  if (errors || ds.errors)
+    Serial.printf("ERROR: %d frames decoded wrong, %lu decode errors\n", errors,
+                  (unsigned long)ds.errors);
+  if (fixtureFailed)
+    Serial.println("ERROR: pixelcodec.py packets decoded wrong");
+  else
+    Serial.println("# pixelcodec.py packets: key and delta frame decoded");
+
+#ifdef NATIVE_HOST
+  exit(errors || ds.errors || fixtureFailed ? 1 : 0);
+#else
+  delay(5000);
+#endif
+}
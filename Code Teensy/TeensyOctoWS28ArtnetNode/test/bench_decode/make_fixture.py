@@ -0,0 +1,84 @@
+# Writes PixelcodecFixture.h: packets coded by Video2Artnet/pixelcodec.py
+# (the sender) for a key frame and a delta frame, with the source frames.
+# main.cpp decodes them with src/PixelDecoder.h and checks the result, so a
+# format change on one side only shows up as an ERROR line.
+#
+# python3 test/bench_decode/make_fixture.py (again after a pixelcodec.py change)
+
+import os
+import sys
+
+here = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(here, "..", "..", "..", "..", "Video2Artnet"))
+from pixelcodec import encodeFrame
+
+NUM_LEDS = 300
+# small packets so the frames are split in several packets
+MAX_LENGTH = 200
+
+
+def keyFrame():
+    frame = bytearray()
+    for i in range(NUM_LEDS):
+        if i < 100:
+            frame += bytes((10, 20, 30))  # flat: RUN
+        elif i < 200:
+            frame += bytes(((i * 7) & 255, (i * 13) & 255, i & 255))  # COPY
+        else:
+            frame += bytes((0, 0, 0))
+    return bytes(frame)
+
+
+def deltaFrame(key):
+    frame = bytearray(key)
+    for i in range(120, 140):  # a few changed pixels: COPY among SKIP
+        frame[i * 3] ^= 0xFF
+    for i in range(250, 290):  # changed flat area: RUN
+        frame[i * 3:i * 3 + 3] = bytes((200, 100, 50))
+    return bytes(frame)
+
+
+def array(name, data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "const uint8_t %s[%d] = {\n%s\n};\n" % (name, len(data), "\n".join(lines))
+
+
+def packets(name, coded):
+    out = ""
+    for i, (first, count, data) in enumerate(coded):
+        out += array("%s%dData" % (name, i), data)
+    out += "const FixturePacket %s[] = {\n" % name
+    for i, (first, count, data) in enumerate(coded):
+        out += "    {%d, %d, %d, %s%dData},\n" % (first, count, len(data), name, i)
+    out += "};\n"
+    return out
+
+
+key = keyFrame()
+delta = deltaFrame(key)
+header = """// Generated by make_fixture.py from Video2Artnet/pixelcodec.py, do not edit
+
+#ifndef PIXELCODECFIXTURE_H
+#define PIXELCODECFIXTURE_H
+
+#include <Arduino.h>
+
+struct FixturePacket {
+  uint16_t firstPixel;
+  uint16_t pixelCount;
+  uint16_t length;
+  const uint8_t *data;
+};
+
+const uint16_t fixtureNumLeds = %d;
+""" % NUM_LEDS
+header += array("fixtureKeyFrame", key)
+header += array("fixtureDeltaFrame", delta)
+header += packets("fixtureKeyPackets", encodeFrame(key, None, MAX_LENGTH))
+header += packets("fixtureDeltaPackets", encodeFrame(delta, key, MAX_LENGTH))
+header += "\n#endif // PIXELCODECFIXTURE_H\n"
+
+with open(os.path.join(here, "PixelcodecFixture.h"), "w") as f:
+    f.write(header)
@@ -0,0 +1,94 @@
+// Teensy OctoWS28 Artnet Node - benchmark samples
+// =================
+// Version: V0.2.1
+//
+// One timed stage of a benchmark: a sample per frame, printed as
+//   bench,<name>,<unit>,<frames>,<min>,<median>,<p99>,<max>
+// On the Teensy samples are CPU cycles of the DWT cycle counter (600 per us),
+// on the host build (NATIVE_HOST) nanoseconds of std::chrono::steady_clock.
+// Both wrap around at 32 bits: a sample must stay under 7 s (Teensy) or 4 s.
+
+#ifndef BENCHSTATS_H
+#define BENCHSTATS_H
+
+#include <Arduino.h>
+#include <algorithm>
+#ifdef NATIVE_HOST
+#include <chrono>
+#endif
+
+class BenchStats {
+public:
+  static const uint16_t MAX_FRAMES = 500;
+
+  explicit BenchStats(const char *_name) : name(_name), count(0), start(0) {}
+
+  // Current time in the unit of the samples
+  static uint32_t now() {
+#ifdef NATIVE_HOST
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#else
+    return ARM_DWT_CYCCNT;
+#endif
+  }
+
+  static const char *unit() {
+#ifdef NATIVE_HOST
+    return "ns";
+#else
+    return "cycles";
+#endif
+  }
+
+  // The Teensy core starts the cycle counter for micros(), make sure anyway
+  static void begin() {
+#ifndef NATIVE_HOST
+    ARM_DEMCR |= ARM_DEMCR_TRCENA;
+    ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+#endif
+  }
+
+  static void printHeader() {
+    Serial.println("bench,name,unit,frames,min,median,p99,max");
+  }
+
+  void reset() { count = 0; }
+
+  // Time a stage with enter() and leave(), several pairs add up in a frame
+  // with add()
+  void enter() { start = now(); }
+  uint32_t leave() { return now() - start; }
+
+  void add(uint32_t sample) {
+    if (count < MAX_FRAMES)
+      samples[count++] = sample;
+  }
+
+  uint16_t size() const { return count; }
+
+  // p99 is the nearest rank: the smallest sample with 99% of the frames at
+  // or below it
+  void print() {
+    uint32_t low = 0, median = 0, p99 = 0, high = 0;
+    if (count) {
+      std::sort(samples, samples + count);
+      low = samples[0];
+      median = samples[(count - 1) / 2];
+      p99 = samples[(count * 99 + 99) / 100 - 1];
+      high = samples[count - 1];
+    }
+    Serial.printf("bench,%s,%s,%u,%lu,%lu,%lu,%lu\n", name, unit(),
+                  (unsigned)count, (unsigned long)low, (unsigned long)median,
+                  (unsigned long)p99, (unsigned long)high);
+  }
+
+private:
+  const char *name;
+  uint16_t count;
+  uint32_t start;
+  uint32_t samples[MAX_FRAMES];
+};
+
+#endif // BENCHSTATS_H
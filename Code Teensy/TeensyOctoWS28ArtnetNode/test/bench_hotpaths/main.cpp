@@ -0,0 +1,244 @@
+// Teensy OctoWS28 Artnet Node - hot path benchmark
+// =================
+// Version: V0.2.1
+//
+// Times each stage a frame goes through on the Etendard V2.a layout (36 pins
+// x 138 GRBW LEDs) and prints min / median / p99 / max per frame as CSV lines
+// (see BenchStats.h), in CPU cycles on the Teensy and ns on the host:
+//  - artnet_read    : Artnet::read() of the universes of a frame, into the
+//                     PacketRing like the node does
+//  - onDmxFrameFull : LEDController::onDmxFrameFull() of every universe,
+//                     direct output (scatter, color pass, latch)
+//  - color_pass     : ColorKernel::apply() on the whole frame
+//  - setPixel       : OctoWS2811::setPixel() of every LED (Teensy only)
+//  - fillplanes     : conversion of the frame to GPIO bit planes, the full
+//                     frame buffer of show() (Teensy only)
+//  - show           : OutputBackend::startOutput() once the previous frame
+//                     is out (OctoWS2811::showAsync() on the Teensy)
+// The bench sends each frame to itself on the Art-Net port. If the Ethernet
+// stack does not loop the packets back, send frames to the node during the
+// run (video2artnet.py): artnet_read then times what arrives.
+//
+// pio run -e etendarv2a_bench -t upload && pio device monitor
+// pio run -e native_bench && .pio/build/native_bench/program
+
+#include <Artnet.h>
+#include <FastLED.h>
+#include <NativeEthernet.h>
+#include <NativeEthernetUdp.h>
+#include <OctoWS2811.h>
+
+#include "../../src/Debug.h"
+#ifdef NATIVE_HOST
+#include "../../src/MemoryBackend.h"
+#else
+#include "../../src/OctoBackend.h"
+#endif
+#include "../../src/PacketRing.h"
+#include "BenchStats.h"
+
+const int numPins = 36;
+const byte pinList[numPins] = {23, 22, 21, 20, 18, 17, 16, 15, 14, 13,
+                               41, 40, 39, 38, 37, 36, 35, 34, 33, 32,
+                               31, 30, 29, 28, 27, 26, 25, 24, 12, 11,
+                               10, 9,  8,  7,  6,  5};
+const int ledsPerStrip = 138;
+const int numLeds = ledsPerStrip * numPins;
+const int pixelsPerUniverse = 170;
+const int maxUniverses =
+    numLeds / pixelsPerUniverse + ((numLeds % pixelsPerUniverse) ? 1 : 0);
+const int BRIGHTNESS = 200;
+const int FRAMES = 200;
+// Longest wait for the universes of a frame to come back from the network
+const uint32_t READ_TIMEOUT_MS = 100;
+
+CRGB rgbarray[numLeds];
+int drawingMemory[numLeds * 4 / 4];
+const uint8_t ledConfig = WS2811_GRBW | WS2811_800kHz;
+#ifdef NATIVE_HOST
+int queueMemory[numLeds * 4 / 4];
+int ledMemory[numLeds * 4 / 4];
+// no output time: show only measures the copy
+MemoryBackend output(drawingMemory, queueMemory, ledMemory,
+                     sizeof(drawingMemory), ledConfig, 0);
+#else
+DMAMEM int displayMemory[numLeds * 4 / 4];
+int spareMemory[numLeds * 4 / 4];
+DMAMEM uint32_t bitBuffer[OCTOWS2811_BITBUFFER_SIZE(ledsPerStrip, 4) / 4]
+    __attribute__((aligned(32)));
+OctoWS2811 octo(ledsPerStrip, displayMemory, drawingMemory, ledConfig, numPins,
+                pinList);
+OctoBackend output(&octo, ledConfig, true);
+#endif
+
+Artnet artnet;
+PacketRing packetRing;
+EthernetUDP sender;
+byte ip[] = {2, 12, 0, 254};
+
+#include "../../src/LEDController.h"
+LEDController *ledController;
+ColorKernel kernel;
+
+// One frame of universes as sent on the network, and as one RGB array
+uint8_t frame[maxUniverses][DMX_MAX_CHANNELS];
+uint8_t frameRGB[numLeds * 3];
+uint8_t colorOut[numLeds * 4];
+uint8_t packet[ART_DMX_START + DMX_MAX_CHANNELS];
+
+BenchStats readStats("artnet_read");
+BenchStats dmxStats("onDmxFrameFull");
+BenchStats colorStats("color_pass");
+BenchStats setPixelStats("setPixel");
+BenchStats fillStats("fillplanes");
+BenchStats showStats("show");
+
+// Send the universes of a frame to the Art-Net port of the node
+void sendFrame(uint8_t sequence) {
+#ifdef NATIVE_HOST
+  IPAddress node(127, 0, 0, 1);
+#else
+  IPAddress node = Ethernet.localIP();
+#endif
+  memcpy(packet, ART_NET_ID, 8);
+  packet[8] = ART_DMX & 0xFF;
+  packet[9] = ART_DMX >> 8;
+  packet[10] = 0;
+  packet[11] = 14;
+  packet[12] = sequence;
+  packet[13] = 0;
+  for (int u = 0; u < maxUniverses; u++) {
+    packet[14] = u & 0xFF;
+    packet[15] = u >> 8;
+    packet[16] = 510 >> 8;
+    packet[17] = 510 & 0xFF;
+    memcpy(packet + ART_DMX_START, frame[u], 510);
+    sender.beginPacket(node, ART_NET_PORT);
+    sender.write(packet, ART_DMX_START + 510);
+    sender.endPacket();
+  }
+}
+
+// Read one frame of universes, only the calls that return a packet count
+void readFrame() {
+  uint32_t total = 0;
+  int received = 0;
+  uint32_t start = millis();
+  while (received < maxUniverses && millis() - start < READ_TIMEOUT_MS) {
+    readStats.enter();
+    uint16_t opcode = artnet.read();
+    uint32_t cycles = readStats.leave();
+    if (opcode == ART_DMX) {
+      total += cycles;
+      received++;
+    }
+    // the render stage is not measured here, drop the packets
+    while (packetRing.size())
+      packetRing.pop();
+    artnet.setPacketBuffer(packetRing.reserve());
+  }
+  if (received == maxUniverses)
+    readStats.add(total);
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial && millis() < 3000) {
+  }
+  Debug::DEBUG = false; // one print per universe would dominate the timings
+  BenchStats::begin();
+
+#ifndef NATIVE_HOST
+  octo.begin();
+  if (!octo.setBitBuffer(bitBuffer))
+    Serial.println("ERROR: strips too long for the full frame DMA");
+  octo.setBuffers(true, spareMemory);
+#endif
+
+  ledController = new LEDController(&output);
+  ledController->setLeds(rgbarray, numLeds);
+  ledController->setUniverses(0, maxUniverses, pixelsPerUniverse);
+  ledController->setStripType(true);
+  ledController->setColorOrder(ledConfig);
+  ledController->setDirectOutput(true);
+  ledController->setBrightness(BRIGHTNESS);
+
+  kernel.setOrder(ledConfig);
+  kernel.setRGBW(true);
+  kernel.setBrightness(BRIGHTNESS);
+
+  uint8_t mac[6] = {0x04, 0xE9, 0xE5, 0x00, 0x00, 0x01};
+  artnet.begin(mac, ip);
+  artnet.setPacketBuffer(packetRing.reserve());
+  artnet.setArtDmxCallback([](uint16_t universe, uint16_t length,
+                              uint8_t sequence, uint8_t *data,
+                              IPAddress remoteIP) {
+    packetRing.push(universe, length, sequence, data);
+    artnet.setPacketBuffer(packetRing.reserve());
+  });
+  sender.begin(ART_NET_PORT + 1);
+
+  for (int u = 0; u < maxUniverses; u++)
+    for (int i = 0; i < DMX_MAX_CHANNELS; i++)
+      frame[u][i] = (u * 7 + i) & 0xFF;
+  for (int i = 0; i < numLeds * 3; i++)
+    frameRGB[i] = frame[i / 510][i % 510];
+}
+
+void loop() {
+  BenchStats *stats[] = {&readStats,     &dmxStats,  &colorStats,
+                         &setPixelStats, &fillStats, &showStats};
+  for (BenchStats *s : stats)
+    s->reset();
+
+  for (int f = 0; f < FRAMES; f++) {
+    sendFrame(f + 1);
+    readFrame();
+
+    dmxStats.enter();
+    for (int u = 0; u < maxUniverses; u++)
+      ledController->onDmxFrameFull(u, 510, f + 1, frame[u]);
+    dmxStats.add(dmxStats.leave());
+
+    colorStats.enter();
+    kernel.apply(frameRGB, colorOut, numLeds);
+    colorStats.add(colorStats.leave());
+
+#ifndef NATIVE_HOST
+    setPixelStats.enter();
+    for (int i = 0; i < numLeds; i++) {
+      const uint8_t *rgb = frameRGB + i * 3;
+      octo.setPixel(i, rgb[0], rgb[1], rgb[2], 0);
+    }
+    setPixelStats.add(setPixelStats.leave());
+#endif
+
+    while (output.isBusy()) {
+    }
+    showStats.enter();
+    output.startOutput();
+    showStats.add(showStats.leave());
+#ifndef NATIVE_HOST
+    fillStats.add(OctoWS2811::fillCycles);
+#endif
+  }
+
+  Serial.printf("# hotpaths %s, %d LEDs, %d universes, %d frames\n",
+#ifdef NATIVE_HOST
+                "host",
+#else
+                "teensy41 600 MHz",
+#endif
+                numLeds, maxUniverses, FRAMES);
+  BenchStats::printHeader();
+  for (BenchStats *s : stats) {
+    if (s->size() || s == &readStats)
+      s->print();
+  }
+
+#ifdef NATIVE_HOST
+  exit(0);
+#else
+  delay(5000);
+#endif
+}
@@ -0,0 +1,180 @@
+// Teensy OctoWS28 Artnet Node - scatter benchmark
+// =================
+// Version: V0.2.1
+//
+// Compares the two ways LEDController turns a complete Artnet frame into
+// OctoWS2811 output on the Etendard V2.a layout (36 pins x 138 GRBW LEDs):
+//  - legacy : Artnet buffer -> ring slot -> CRGB array -> FastLED.show()
+//             -> drawingMemory, show() copies it to the frame buffer
+//  - direct : received in the ring slot, scattered straight into the draw
+//             buffer, show() rotates the buffers (as src/main.cpp does)
+// Prints the time per frame of assembling the universes and of the show,
+// then the bytes each stage copied or wrote per frame, read from the
+// counters of PacketRing, LEDController and OctoWS2811. No network needed.
+//
+// pio run -e etendarv2a_bench_scatter -t upload && pio device monitor
+
+#include <Artnet.h>
+#include <FastLED.h>
+#include <OctoWS2811.h>
+
+#include "../../src/Debug.h"
+#include "../../src/OctoBackend.h"
+#include "../../src/PacketRing.h"
+
+const int numPins = 36;
+const byte pinList[numPins] = {23, 22, 21, 20, 18, 17, 16, 15, 14, 13,
+                               41, 40, 39, 38, 37, 36, 35, 34, 33, 32,
+                               31, 30, 29, 28, 27, 26, 25, 24, 12, 11,
+                               10, 9,  8,  7,  6,  5};
+const int ledsPerStrip = 138;
+const int numLeds = ledsPerStrip * numPins;
+const int pixelsPerUniverse = 170;
+const int maxUniverses =
+    numLeds / pixelsPerUniverse + ((numLeds % pixelsPerUniverse) ? 1 : 0);
+const int BRIGHTNESS = 200;
+const int FRAMES = 100;
+
+CRGB rgbarray[numLeds];
+DMAMEM int displayMemory[ledsPerStrip * numPins * 4 / 4];
+int drawingMemory[ledsPerStrip * numPins * 4 / 4];
+// Third buffer of the rotation, the direct path only
+int spareMemory[ledsPerStrip * numPins * 4 / 4];
+const uint8_t ledConfig = WS2811_GRBW | WS2811_800kHz;
+OctoWS2811 octo(ledsPerStrip, displayMemory, drawingMemory, ledConfig, numPins,
+                pinList);
+OctoBackend output(&octo, ledConfig, true);
+
+#include "../../src/LEDController.h"
+LEDController::CTeensy4Controller *pcontroller;
+LEDController *legacy;
+LEDController *direct;
+
+// One frame worth of universes, as received from the network
+uint8_t frame[maxUniverses][DMX_MAX_CHANNELS];
+// Stands in for the Artnet receive buffer of the legacy path
+uint8_t artnetPacket[MAX_BUFFER_ARTNET];
+PacketRing ring;
+
+// Bytes copied or written by each stage, summed over the frames of a run
+struct StageBytes {
+  uint32_t received;   // Udp.read() into the receive buffer
+  uint32_t ring;       // receive buffer -> ring slot
+  uint32_t controller; // ring slot -> CRGB array and draw buffer
+  uint32_t show;       // draw buffer -> frame buffer
+
+  void begin(PacketRing &r, LEDController *c) {
+    received = 0;
+    ring = r.getCopiedBytes();
+    controller = c->getBytesWritten();
+    show = OctoWS2811::copyBytes;
+  }
+
+  void end(PacketRing &r, LEDController *c) {
+    ring = r.getCopiedBytes() - ring;
+    controller = c->getBytesWritten() - controller;
+    show = OctoWS2811::copyBytes - show;
+  }
+
+  void print(const char *path) {
+    Serial.printf("%s bytes per frame: received %lu, ring %lu, controller %lu, "
+                  "show %lu, total %lu\n",
+                  path, (unsigned long)(received / FRAMES),
+                  (unsigned long)(ring / FRAMES),
+                  (unsigned long)(controller / FRAMES),
+                  (unsigned long)(show / FRAMES),
+                  (unsigned long)((received + ring + controller + show) /
+                                  FRAMES));
+  }
+};
+
+// Feed one frame to the controller, the way the receive callbacks and
+// render() do: legacy receives in the Artnet buffer and push() copies it,
+// direct receives in the slot reserved in the ring
+uint32_t assemble(LEDController *controller, bool zeroCopy,
+                  StageBytes &bytes) {
+  uint32_t start = micros();
+  for (int u = 0; u < maxUniverses; u++) {
+    uint8_t *packet = zeroCopy ? ring.reserve() : artnetPacket;
+    // stands in for Udp.read()
+    memcpy(packet + ART_DMX_START, frame[u], 510);
+    bytes.received += 510;
+    ring.push(u, 510, 0, packet + ART_DMX_START);
+    controller->onDmxFrameFull(u, 510, 0, ring.front()->data());
+    ring.pop();
+  }
+  return micros() - start;
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial && millis() < 3000) {
+  }
+  Debug::DEBUG = false; // one print per universe would dominate the timings
+  octo.begin();
+
+  legacy = new LEDController(&output);
+  legacy->setLeds(rgbarray, numLeds);
+  legacy->setUniverses(0, maxUniverses, pixelsPerUniverse);
+  legacy->setStripType(true);
+  legacy->setColorOrder(ledConfig);
+  pcontroller = new LEDController::CTeensy4Controller(&output, *legacy);
+  FastLED.addLeds(pcontroller, rgbarray, numLeds);
+  FastLED.setBrightness(BRIGHTNESS);
+
+  direct = new LEDController(&output);
+  direct->setLeds(rgbarray, numLeds);
+  direct->setUniverses(0, maxUniverses, pixelsPerUniverse);
+  direct->setStripType(true);
+  direct->setColorOrder(ledConfig);
+  direct->setDirectOutput(true);
+  direct->setBrightness(BRIGHTNESS);
+
+  for (int u = 0; u < maxUniverses; u++)
+    for (int i = 0; i < DMX_MAX_CHANNELS; i++)
+      frame[u][i] = (u * 7 + i) & 0xFF;
+}
+
+void loop() {
+  Serial.printf("\n%d LEDs, %d universes, %d frames\n", numLeds, maxUniverses,
+                FRAMES);
+
+  // legacy: show() copies the drawing buffer to the frame buffer
+  octo.setBuffers(false);
+  StageBytes legacyBytes;
+  legacyBytes.begin(ring, legacy);
+  uint32_t assembleUs = 0, showUs = 0;
+  for (int f = 0; f < FRAMES; f++) {
+    while (octo.busy()) {
+    }
+    assembleUs += assemble(legacy, false, legacyBytes);
+    uint32_t start = micros();
+    FastLED.show();
+    showUs += micros() - start;
+  }
+  legacyBytes.end(ring, legacy);
+  Serial.printf("legacy: assemble %lu us, show %lu us per frame\n",
+                assembleUs / FRAMES, showUs / FRAMES);
+
+  // direct: the buffers rotate, a frame is queued by present()
+  octo.setBuffers(true, spareMemory);
+  StageBytes directBytes;
+  directBytes.begin(ring, direct);
+  assembleUs = showUs = 0;
+  for (int f = 0; f < FRAMES; f++) {
+    while (octo.busy()) {
+    }
+    assembleUs += assemble(direct, true, directBytes);
+    uint32_t start = micros();
+    octo.show();
+    showUs += micros() - start;
+  }
+  directBytes.end(ring, direct);
+  Serial.printf("direct: assemble %lu us, show %lu us per frame\n",
+                assembleUs / FRAMES, showUs / FRAMES);
+
+  legacyBytes.print("legacy");
+  directBytes.print("direct");
+
+  delay(5000);
+}
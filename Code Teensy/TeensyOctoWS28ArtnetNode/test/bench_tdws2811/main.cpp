@@ -0,0 +1,108 @@
+// Teensy OctoWS28 Artnet Node - TDWS2811 fill benchmark
+// =================
+// Version: V0.2.1
+//
+// Compares the two ways of filling the TDWS2811 bit buffer with a whole frame
+// of 32 channels x 138 GRBW LEDs (the Etendard V2.a strip length):
+//  - per pixel : PixelDriver::setPixel(), one read-modify-write per bit
+//  - bulk      : PixelDriver::setFrame(), 8x8 bit transposes, one store per
+//                bit time
+// Checks that both give the same buffer and prints the time per frame, then
+// decodes the buffer with the WS2811Waveform golden model: each channel must
+// read back its strip with WS2812B timing.
+// No LEDs needed.
+//
+// pio run -e etendarv2a_bench_tdws2811 -t upload && pio device monitor
+
+#include <TDWS2811.h>
+
+#include "../waveform/WS2811Waveform.h"
+
+using namespace TDWS28XX;
+
+const uint8_t numChannels = 32;
+const uint16_t ledsPerStrip = 138;
+const int bytesPerLED = 4;
+const int FRAMES = 20;
+
+DMAMEM PixelBuffer<ledsPerStrip, QUADCOLOR, SINGLE_BUFFER> pb;
+PixelDriver pd(pb);
+
+// One frame, channel after channel, each pixel in G, R, B, W order
+uint8_t frame[numChannels * ledsPerStrip * bytesPerLED];
+// Copy of the bit buffer filled by setPixel()
+uint32_t reference[sizeof(pb.buffer) / 4];
+
+void fillPerPixel() {
+  const uint8_t *px = frame;
+  for (uint8_t c = 0; c < numChannels; c++) {
+    for (uint16_t i = 0; i < ledsPerStrip; i++) {
+      pd.setPixel(c, i, grbw(px[0], px[1], px[2], px[3]));
+      px += bytesPerLED;
+    }
+  }
+}
+
+// Every channel as its first pixel reads it, with the nominal thirds of
+// 1 / 2.4 MHz: all channels high, then the data, then all low
+bool decodeMatches() {
+  WS2811Waveform *wf = new WS2811Waveform(WS2812B_TIMING);
+  wf->watch(0, 0xFFFFFFFF);
+  double ns = 0;
+  wf->tdwsBuffer((const uint32_t *)pd.getActiveBufferPtr(),
+                 pd.getBufferSize() / 4, 0xFFFFFFFF, 0, ns, 1e9f / 2.4e6f);
+  wf->end();
+
+  const size_t bytesPerStrip = ledsPerStrip * bytesPerLED;
+  bool ok = true;
+  for (uint8_t c = 0; c < numChannels; c++) {
+    WS2811Pin &p = wf->pin(0, c);
+    if (p.frames.size() != 1 || p.frames[0].size() != bytesPerStrip ||
+        memcmp(p.frames[0].data(), frame + c * bytesPerStrip, bytesPerStrip) ||
+        p.badHigh || p.badPeriod)
+      ok = false;
+  }
+  delete wf;
+  return ok;
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial && millis() < 3000) {
+  }
+  for (uint8_t c = 0; c < numChannels; c++)
+    pd.setChannelType(c, GRBW);
+  if (!pd.begin())
+    Serial.println("ERROR: PixelDriver::begin");
+
+  for (size_t i = 0; i < sizeof(frame); i++)
+    frame[i] = (i * 7 + (i >> 8)) & 0xFF;
+}
+
+void loop() {
+  Serial.printf("\n%d channels x %d LEDs, %d frames\n", numChannels,
+                ledsPerStrip, FRAMES);
+
+  uint32_t start = micros();
+  for (int f = 0; f < FRAMES; f++)
+    fillPerPixel();
+  uint32_t perPixelUs = (micros() - start) / FRAMES;
+  memcpy(reference, (const void *)pd.getActiveBufferPtr(), sizeof(reference));
+
+  memset((void *)pd.getActiveBufferPtr(), 0, pd.getBufferSize());
+  start = micros();
+  for (int f = 0; f < FRAMES; f++)
+    pd.setFrame(frame, numChannels);
+  uint32_t bulkUs = (micros() - start) / FRAMES;
+
+  bool same = !memcmp(reference, (const void *)pd.getActiveBufferPtr(),
+                      sizeof(reference));
+  Serial.printf("per pixel: %lu us per frame\n", perPixelUs);
+  Serial.printf("bulk:      %lu us per frame (%s)\n", bulkUs,
+                same ? "same buffer" : "ERROR: buffers differ");
+  Serial.printf("decoded:   %s\n",
+                decodeMatches() ? "every channel reads its strip"
+                                : "ERROR: a channel differs");
+
+  delay(5000);
+}
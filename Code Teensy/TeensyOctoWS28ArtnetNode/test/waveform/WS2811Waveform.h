@@ -0,0 +1,203 @@
+// Teensy OctoWS28 Artnet Node - WS2811 waveform golden model
+// =================
+// Version: V0.2.1
+//
+// Decodes LED data lines the way a WS2811 / WS2812B / SK6812 pixel reads
+// them: a rising edge starts a bit, its high time gives the value, a low line
+// longer than the reset time latches the frame. The buffers of the output
+// drivers are turned into pin levels by:
+//  - octoPlanes(): OctoWS2811 bit planes, as its 3 DMA channels write them to
+//    GPIO_DR_SET and GPIO_DR_CLEAR on each bit time. set() and clear() take
+//    the GPIO writes one at a time instead (see test/waveform/host).
+//  - tdwsBuffer(): TriantaduoWS2811 buffer, one word per bit time, shifted out
+//    in three thirds (high, data, low).
+// A new fill kernel is bit exact when every pin decodes to the bytes of its
+// strip with no timing error.
+
+#ifndef WS2811_WAVEFORM_H
+#define WS2811_WAVEFORM_H
+
+#include <stdint.h>
+#include <vector>
+
+// What a pixel accepts, in ns
+struct WS2811Timing {
+  float t0hMin, t0hMax; // high time of a 0 bit
+  float t1hMin, t1hMax; // high time of a 1 bit
+  float bitMin, bitMax; // rising edge to rising edge
+  float reset;          // shortest low time that latches the frame
+};
+
+// SK6812 datasheet: T0H 0.30us, T1H 0.60us, T0H + T0L 1.20us, all +/- 0.15us,
+// reset 80us
+static const WS2811Timing SK6812_TIMING = {150, 450, 450, 750, 900, 1500, 80000};
+// WS2812B datasheet: T0H 0.40us, T1H 0.80us +/- 0.15us, TH + TL 1.25us
+// +/- 0.60us, reset 50us
+static const WS2811Timing WS2812B_TIMING = {250, 550, 650, 950, 650, 1850, 50000};
+
+// One data line as seen by the first pixel of the strip
+class WS2811Pin {
+public:
+  std::vector<std::vector<uint8_t>> frames; // bytes of each latched frame
+  uint32_t badHigh = 0;      // high times in neither range
+  uint32_t badPeriod = 0;    // bit periods out of range, shorter than a reset
+  uint32_t partialBytes = 0; // frames latched in the middle of a byte
+  uint32_t count[2] = {0, 0};
+  float highMin[2] = {1e9f, 1e9f}, highMax[2] = {0, 0};
+  float periodMin = 1e9f, periodMax = 0;
+
+  void level(const WS2811Timing &t, double ns, bool high) {
+    if (high == isHigh)
+      return;
+    isHigh = high;
+    if (high) {
+      if (inFrame) {
+        if (ns - fall >= t.reset) {
+          latch();
+        } else {
+          float period = ns - rise;
+          if (period < periodMin)
+            periodMin = period;
+          if (period > periodMax)
+            periodMax = period;
+          if (period < t.bitMin || period > t.bitMax)
+            badPeriod++;
+        }
+      }
+      rise = ns;
+      inFrame = true;
+      return;
+    }
+    fall = ns;
+    float h = ns - rise;
+    uint8_t bit;
+    if (h >= t.t0hMin && h <= t.t0hMax) {
+      bit = 0;
+    } else if (h >= t.t1hMin && h <= t.t1hMax) {
+      bit = 1;
+    } else {
+      badHigh++;
+      bit = h > (t.t0hMax + t.t1hMin) / 2;
+    }
+    count[bit]++;
+    if (h < highMin[bit])
+      highMin[bit] = h;
+    if (h > highMax[bit])
+      highMax[bit] = h;
+    value = (value << 1) | bit;
+    if (++bits % 8 == 0)
+      current.push_back(value);
+  }
+
+  // The line stays low from here on
+  void end() {
+    if (inFrame && !isHigh)
+      latch();
+  }
+
+private:
+  bool isHigh = false;
+  bool inFrame = false;
+  double rise = 0, fall = 0;
+  uint8_t value = 0;
+  uint32_t bits = 0;
+  std::vector<uint8_t> current;
+
+  void latch() {
+    if (bits % 8)
+      partialBytes++;
+    frames.push_back(current);
+    current.clear();
+    bits = 0;
+    inFrame = false;
+  }
+};
+
+// The LED pins of up to 4 GPIO ports of 32 bits
+class WS2811Waveform {
+public:
+  WS2811Timing timing;
+  uint32_t stray[4] = {0, 0, 0, 0}; // pin writes outside watch()
+
+  explicit WS2811Waveform(const WS2811Timing &t) : timing(t) {}
+
+  // Pins to decode, writes to the others are counted as stray
+  void watch(uint8_t port, uint32_t mask) { watched[port] |= mask; }
+  uint32_t watching(uint8_t port) const { return watched[port]; }
+  WS2811Pin &pin(uint8_t port, uint8_t bit) { return pins[port][bit]; }
+
+  void set(uint8_t port, uint32_t mask, double ns) {
+    stray[port] += __builtin_popcount(mask & ~watched[port]);
+    change(port, mask & ~levels[port], true, ns);
+  }
+
+  void clear(uint8_t port, uint32_t mask, double ns) {
+    stray[port] += __builtin_popcount(mask & ~watched[port]);
+    change(port, mask & levels[port], false, ns);
+  }
+
+  // Whole port written, like the outputs of a shift register
+  void write(uint8_t port, uint32_t value, double ns) {
+    stray[port] += __builtin_popcount((value ^ levels[port]) & ~watched[port]);
+    change(port, value & ~levels[port], true, ns);
+    change(port, ~value & levels[port], false, ns);
+  }
+
+  // Every line stays low, the last frames are latched
+  void end() {
+    for (uint8_t port = 0; port < 4; port++) {
+      change(port, levels[port], false, lastNs);
+      for (uint8_t bit = 0; bit < 32; bit++)
+        pins[port][bit].end();
+    }
+  }
+
+  // n bit times of OctoWS2811 bit planes, 4 words (GPIO1 to GPIO4) each: the
+  // pins of bitmask go high, those set in the plane go low at t0h (0 bit),
+  // the others at t1h. ns is the start of the first bit time, updated.
+  void octoPlanes(const uint32_t bitmask[4], const uint32_t *planes, uint32_t n,
+                  double &ns, float period, float t0h, float t1h) {
+    for (uint32_t i = 0; i < n; i++, planes += 4, ns += period) {
+      for (uint8_t port = 0; port < 4; port++) {
+        set(port, bitmask[port], ns);
+        clear(port, planes[port], ns + t0h);
+        clear(port, bitmask[port], ns + t1h);
+      }
+    }
+  }
+
+  // n bit times of a TriantaduoWS2811 buffer on port 0, bit c of a word
+  // driving channel c: each bit time shifts out the ones word, the data word
+  // and the zeros word, for third ns each.
+  void tdwsBuffer(const uint32_t *words, uint32_t n, uint32_t ones,
+                  uint32_t zeros, double &ns, float third) {
+    for (uint32_t i = 0; i < n; i++, ns += 3 * third) {
+      write(0, ones, ns);
+      write(0, words[i], ns + third);
+      write(0, zeros, ns + 2 * third);
+    }
+  }
+
+private:
+  WS2811Pin pins[4][32];
+  uint32_t levels[4] = {0, 0, 0, 0};
+  uint32_t watched[4] = {0, 0, 0, 0};
+  double lastNs = 0;
+
+  void change(uint8_t port, uint32_t mask, bool high, double ns) {
+    if (ns > lastNs)
+      lastNs = ns;
+    if (high)
+      levels[port] |= mask;
+    else
+      levels[port] &= ~mask;
+    mask &= watched[port];
+    while (mask) {
+      uint8_t bit = __builtin_ctz(mask);
+      mask &= mask - 1;
+      pins[port][bit].level(timing, ns, high);
+    }
+  }
+};
+
+#endif // WS2811_WAVEFORM_H
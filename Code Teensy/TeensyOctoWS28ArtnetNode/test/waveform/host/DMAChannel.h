@@ -0,0 +1,79 @@
+// Teensy OctoWS28 Artnet Node - waveform check
+// =================
+// Version: V0.2.1
+//
+// DMAChannel and DMASetting of the Teensy 4 core, on the host: the TCD
+// fields keep their names and meaning, imxrt_sim.cpp runs the transfers.
+
+#ifndef DMACHANNEL_H_HOST
+#define DMACHANNEL_H_HOST
+
+#include "imxrt.h"
+#include <stdint.h>
+
+#define DMA_TCD_ATTR_SSIZE(n) (((n) & 0x7) << 8)
+#define DMA_TCD_ATTR_SMOD(n) (((n) & 0x1F) << 11)
+#define DMA_TCD_ATTR_DSIZE(n) (((n) & 0x7) << 0)
+#define DMA_TCD_ATTR_DMOD(n) (((n) & 0x1F) << 3)
+#define DMA_TCD_NBYTES_SMLOE ((uint32_t)1 << 31)
+#define DMA_TCD_NBYTES_DMLOE ((uint32_t)1 << 30)
+#define DMA_TCD_NBYTES_MLOFFYES_MLOFF(n) ((uint32_t)(((n) & 0xFFFFF) << 10))
+#define DMA_TCD_NBYTES_MLOFFYES_NBYTES(n) ((uint32_t)(((n) & 0x3FF) << 0))
+#define DMA_TCD_CSR_INTMAJOR 0x0002
+#define DMA_TCD_CSR_DREQ 0x0008
+#define DMA_TCD_CSR_ESG 0x0010
+#define DMA_TCD_CSR_DONE 0x0080
+
+#define DMAMUX_SOURCE_XBAR1_0 94
+#define DMAMUX_SOURCE_XBAR1_1 95
+#define DMAMUX_SOURCE_XBAR1_2 96
+
+extern "C" void xbar_connect(unsigned int input, unsigned int output);
+
+class DMABaseClass {
+public:
+  typedef struct {
+    volatile const void *volatile SADDR;
+    int16_t SOFF;
+    uint16_t ATTR;
+    uint32_t NBYTES_MLOFFYES;
+    int32_t SLAST;
+    volatile void *volatile DADDR;
+    int16_t DOFF;
+    volatile uint16_t CITER_ELINKNO;
+    int32_t DLASTSGA;
+    volatile uint16_t CSR;
+    volatile uint16_t BITER_ELINKNO;
+  } TCD_t;
+  TCD_t *TCD;
+};
+
+class DMASetting : public DMABaseClass {
+public:
+  DMASetting();
+  TCD_t tcd;
+};
+
+class DMAChannel : public DMABaseClass {
+public:
+  DMAChannel();
+  void begin() {}
+  DMAChannel &operator=(const DMASetting &rhs) {
+    *TCD = *rhs.TCD;
+    return *this;
+  }
+  void triggerAtHardwareEvent(uint8_t source) { this->source = source; }
+  void attachInterrupt(void (*isr)(void)) { this->isr = isr; }
+  void enable() { enabled = true; }
+  void disable() { enabled = false; }
+  void clearInterrupt() {}
+  bool complete() { return TCD->CSR & DMA_TCD_CSR_DONE; }
+  void clearComplete() { TCD->CSR &= ~DMA_TCD_CSR_DONE; }
+
+  TCD_t tcd;
+  uint8_t source = 0;
+  bool enabled = false; // DMA_ERQ
+  void (*isr)(void) = nullptr;
+};
+
+#endif // DMACHANNEL_H_HOST
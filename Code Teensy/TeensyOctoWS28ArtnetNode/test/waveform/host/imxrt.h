@@ -0,0 +1,114 @@
+// Teensy OctoWS28 Artnet Node - waveform check
+// =================
+// Version: V0.2.1
+//
+// The registers, pins and cache helpers of the Teensy 4 core used by
+// OctoWS2811.cpp, on the host. Registers are plain memory, read by the
+// simulation in imxrt_sim.cpp:
+//  - GPIO1 to GPIO4 and GPIO6 to GPIO9 keep their distance
+//    (standard_gpio_addr() in OctoWS2811.cpp), each port 16384 bytes apart
+//  - pin p is on port p % 4 (GPIO6 to GPIO9), bit (5 * (p / 4) + 3 * (p % 4))
+//    % 32: a synthetic map, every port gets several groups of 8 pins
+
+#ifndef IMXRT_H_HOST
+#define IMXRT_H_HOST
+
+#include <stdint.h>
+
+#define F_BUS_ACTUAL 150000000
+#define NUM_DIGITAL_PINS 55
+
+// GPIO: standard ports at the start, fast ports 0x01E48000 bytes further
+#define HOST_GPIO_FAST 0x01E48000
+#define HOST_GPIO_SIZE (HOST_GPIO_FAST + 4 * 16384)
+extern uint8_t host_gpio[HOST_GPIO_SIZE];
+#define HOST_REG(offset) (*(volatile uint32_t *)(host_gpio + (offset)))
+#define GPIO1_DR HOST_REG(0x00)
+#define GPIO1_DR_SET HOST_REG(0x84)
+#define GPIO1_DR_CLEAR HOST_REG(0x88)
+#define GPIO6_DR HOST_REG(HOST_GPIO_FAST)
+
+inline uint8_t digitalPinToBit(uint8_t pin) {
+  return (5 * (pin / 4) + 3 * (pin % 4)) % 32;
+}
+inline volatile uint32_t *portOutputRegister(uint8_t pin) {
+  return &HOST_REG(HOST_GPIO_FAST + (pin % 4) * 16384);
+}
+inline volatile uint32_t *portModeRegister(uint8_t pin) {
+  return &HOST_REG(HOST_GPIO_FAST + (pin % 4) * 16384 + 4);
+}
+
+extern volatile uint32_t host_iomuxc_gpr[34];
+#define IOMUXC_GPR_GPR26 (host_iomuxc_gpr[26])
+
+// QuadTimer4
+extern volatile uint16_t host_tmr4[3][8];
+extern volatile uint16_t host_tmr4_enbl;
+#define TMR4_COMP10 (host_tmr4[0][0])
+#define TMR4_COMP11 (host_tmr4[1][0])
+#define TMR4_COMP12 (host_tmr4[2][0])
+#define TMR4_CMPLD10 (host_tmr4[0][1])
+#define TMR4_CMPLD11 (host_tmr4[1][1])
+#define TMR4_CMPLD12 (host_tmr4[2][1])
+#define TMR4_CNTR0 (host_tmr4[0][2])
+#define TMR4_CNTR1 (host_tmr4[1][2])
+#define TMR4_CNTR2 (host_tmr4[2][2])
+#define TMR4_LOAD0 (host_tmr4[0][3])
+#define TMR4_LOAD1 (host_tmr4[1][3])
+#define TMR4_LOAD2 (host_tmr4[2][3])
+#define TMR4_CTRL0 (host_tmr4[0][4])
+#define TMR4_CTRL1 (host_tmr4[1][4])
+#define TMR4_CTRL2 (host_tmr4[2][4])
+#define TMR4_SCTRL0 (host_tmr4[0][5])
+#define TMR4_SCTRL1 (host_tmr4[1][5])
+#define TMR4_SCTRL2 (host_tmr4[2][5])
+#define TMR4_CSCTRL0 (host_tmr4[0][6])
+#define TMR4_ENBL host_tmr4_enbl
+#define TMR_CTRL_CM(n) ((uint16_t)(((n) & 0x07) << 13))
+#define TMR_CTRL_PCS(n) ((uint16_t)(((n) & 0x0F) << 9))
+#define TMR_CTRL_LENGTH ((uint16_t)(1 << 5))
+#define TMR_CTRL_COINIT ((uint16_t)(1 << 3))
+#define TMR_CTRL_OUTMODE(n) ((uint16_t)(((n) & 0x07) << 0))
+#define TMR_SCTRL_OEN ((uint16_t)(1 << 0))
+#define TMR_SCTRL_FORCE ((uint16_t)(1 << 2))
+#define TMR_SCTRL_MSTR ((uint16_t)(1 << 5))
+#define TMR_CSCTRL_CL1(n) ((uint16_t)(((n) & 0x03) << 0))
+#define TMR_CSCTRL_TCF1EN ((uint16_t)(1 << 6))
+
+// XBAR1 and clock gates
+extern volatile uint16_t host_xbara1_ctrl[2];
+extern volatile uint32_t host_ccm_ccgr2;
+#define XBARA1_CTRL0 (host_xbara1_ctrl[0])
+#define XBARA1_CTRL1 (host_xbara1_ctrl[1])
+#define XBARA_CTRL_STS1 ((uint16_t)(1 << 12))
+#define XBARA_CTRL_EDGE1(n) ((uint16_t)(((n) & 0x03) << 10))
+#define XBARA_CTRL_DEN1 ((uint16_t)(1 << 8))
+#define XBARA_CTRL_STS0 ((uint16_t)(1 << 4))
+#define XBARA_CTRL_EDGE0(n) ((uint16_t)(((n) & 0x03) << 2))
+#define XBARA_CTRL_DEN0 ((uint16_t)(1 << 0))
+#define XBARA1_IN_QTIMER4_TIMER0 36
+#define XBARA1_IN_QTIMER4_TIMER1 37
+#define XBARA1_IN_QTIMER4_TIMER2 38
+#define XBARA1_OUT_DMA_CH_MUX_REQ30 0
+#define XBARA1_OUT_DMA_CH_MUX_REQ31 1
+#define XBARA1_OUT_DMA_CH_MUX_REQ94 2
+#define CCM_CCGR2 host_ccm_ccgr2
+#define CCM_CCGR2_XBAR1(n) ((uint32_t)(((n) & 0x03) << 22))
+#define CCM_CCGR_ON 3
+
+// Cycle counter: 600 per us of host time
+#define ARM_DWT_CYCCNT (host_cycles())
+uint32_t host_cycles();
+
+inline void arm_dcache_flush_delete(void *addr, uint32_t size) {}
+
+// Run QuadTimer4 once show() has enabled it: on each bit time, timers 0, 1
+// and 2 request the DMA channels triggered by XBAR1 outputs 0, 1 and 2, until
+// the channel of timer 2 completes its major loop. Writes to GPIO1-4 go to
+// gpio() with the register offset and their time in ns from the first bit.
+// Returns false on a transfer to any other address, or if another of the 3
+// channels is still enabled after the last bit.
+bool host_run_qtimer4(void (*gpio)(uint8_t port, uint32_t reg, uint32_t value,
+                                   double ns));
+
+#endif // IMXRT_H_HOST
@@ -0,0 +1,189 @@
+// Teensy OctoWS28 Artnet Node - waveform check
+// =================
+// Version: V0.2.1
+//
+// Registers of imxrt.h and a model of the eDMA transfers OctoWS2811 sets up:
+// minor loops of NBYTES with SOFF/DOFF, SMOD/DMOD, the minor loop offset,
+// SLAST/DLASTSGA, and at the end of a major loop the DREQ, ESG (scatter
+// gather to another TCD) and INTMAJOR bits of CSR.
+
+#include "DMAChannel.h"
+
+#include <string.h>
+#include <time.h>
+
+uint8_t host_gpio[HOST_GPIO_SIZE];
+volatile uint32_t host_iomuxc_gpr[34];
+volatile uint16_t host_tmr4[3][8];
+volatile uint16_t host_tmr4_enbl;
+volatile uint16_t host_xbara1_ctrl[2];
+volatile uint32_t host_ccm_ccgr2;
+
+extern "C" void xbar_connect(unsigned int input, unsigned int output) {}
+
+uint32_t host_cycles() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint32_t)((uint64_t)now.tv_sec * 600000000 + now.tv_nsec * 3 / 5);
+}
+
+// Constructed before main(): plain arrays, no constructor to run first
+static DMABaseClass::TCD_t *settings[16];
+static uint8_t numSettings;
+static DMAChannel *channels[16];
+static uint8_t numChannels;
+
+DMASetting::DMASetting() : tcd() {
+  TCD = &tcd;
+  if (numSettings < 16)
+    settings[numSettings++] = &tcd;
+}
+
+DMAChannel::DMAChannel() : tcd() {
+  TCD = &tcd;
+  if (numChannels < 16)
+    channels[numChannels++] = this;
+}
+
+static void (*gpioWrite)(uint8_t port, uint32_t reg, uint32_t value, double ns);
+static double now;
+static bool failed;
+
+static uintptr_t advance(uintptr_t addr, int32_t offset, unsigned mod) {
+  if (!mod)
+    return addr + offset;
+  uintptr_t mask = ((uintptr_t)1 << mod) - 1;
+  return (addr & ~mask) | ((addr + offset) & mask);
+}
+
+static void store(uintptr_t addr, uint32_t value, unsigned size) {
+  uintptr_t offset = addr - (uintptr_t)host_gpio;
+  if (addr < (uintptr_t)host_gpio || offset >= 4 * 16384 || size != 4 ||
+      offset % 4) {
+    failed = true;
+    return;
+  }
+  uint8_t port = offset >> 14;
+  uint32_t reg = offset & 0x3FFF;
+  volatile uint32_t &dr = HOST_REG(port * 16384);
+  if (reg == 0x84) {
+    dr |= value;
+  } else if (reg == 0x88) {
+    dr &= ~value;
+  } else if (reg == 0x8C) {
+    dr ^= value;
+  } else if (reg == 0) {
+    dr = value;
+  }
+  gpioWrite(port, reg, value, now);
+}
+
+// One hardware request: a minor loop, and the end of the major loop
+static void request(DMAChannel *ch) {
+  if (!ch || !ch->enabled)
+    return;
+  DMABaseClass::TCD_t *t = ch->TCD;
+  unsigned ssize = 1 << ((t->ATTR >> 8) & 7);
+  unsigned dsize = 1 << (t->ATTR & 7);
+  unsigned smod = (t->ATTR >> 11) & 0x1F;
+  unsigned dmod = (t->ATTR >> 3) & 0x1F;
+  uint32_t nbytes = t->NBYTES_MLOFFYES;
+  bool smloe = nbytes & DMA_TCD_NBYTES_SMLOE;
+  bool dmloe = nbytes & DMA_TCD_NBYTES_DMLOE;
+  int32_t mloff = (int32_t)(nbytes << 2) >> 12; // bits 10 to 29
+  nbytes &= (smloe || dmloe) ? 0x3FF : 0x3FFFFFFF;
+
+  uintptr_t s = (uintptr_t)t->SADDR;
+  uintptr_t d = (uintptr_t)t->DADDR;
+  uint8_t fifo[16];
+  unsigned fill = 0;
+  for (uint32_t n = 0; n < nbytes; n += ssize) {
+    memcpy(fifo + fill, (const void *)s, ssize);
+    fill += ssize;
+    s = advance(s, t->SOFF, smod);
+    while (fill >= dsize) {
+      uint32_t value = 0;
+      memcpy(&value, fifo, dsize < 4 ? dsize : 4);
+      store(d, value, dsize);
+      fill -= dsize;
+      memmove(fifo, fifo + dsize, fill);
+      d = advance(d, t->DOFF, dmod);
+    }
+  }
+
+  if (--t->CITER_ELINKNO) {
+    if (smloe)
+      s += mloff;
+    if (dmloe)
+      d += mloff;
+    t->SADDR = (const void *)s;
+    t->DADDR = (void *)d;
+    return;
+  }
+
+  // the last minor loop applies SLAST and DLASTSGA instead of the offset
+  uint16_t csr = t->CSR;
+  t->CITER_ELINKNO = t->BITER_ELINKNO;
+  t->SADDR = (const void *)(s + t->SLAST);
+  if (csr & DMA_TCD_CSR_ESG) {
+    // DLASTSGA holds the low 32 bits of the address of the next TCD
+    uint8_t i;
+    for (i = 0; i < numSettings; i++) {
+      if ((int32_t)(uintptr_t)settings[i] == t->DLASTSGA)
+        break;
+    }
+    if (i == numSettings) {
+      failed = true;
+      ch->enabled = false;
+      return;
+    }
+    *t = *settings[i];
+  } else {
+    t->DADDR = (void *)(d + t->DLASTSGA);
+    t->CSR = csr | DMA_TCD_CSR_DONE;
+  }
+  if (csr & DMA_TCD_CSR_DREQ)
+    ch->enabled = false;
+  if ((csr & DMA_TCD_CSR_INTMAJOR) && ch->isr)
+    ch->isr();
+}
+
+static DMAChannel *channelFor(uint8_t source) {
+  for (uint8_t i = 0; i < numChannels; i++) {
+    if (channels[i]->source == source)
+      return channels[i];
+  }
+  return nullptr;
+}
+
+bool host_run_qtimer4(void (*gpio)(uint8_t port, uint32_t reg, uint32_t value,
+                                   double ns)) {
+  DMAChannel *timer[3] = {channelFor(DMAMUX_SOURCE_XBAR1_0),
+                          channelFor(DMAMUX_SOURCE_XBAR1_1),
+                          channelFor(DMAMUX_SOURCE_XBAR1_2)};
+  if ((TMR4_ENBL & 7) != 7 || !timer[2])
+    return false;
+  gpioWrite = gpio;
+  failed = false;
+
+  // timer 0 counts up to COMP1 and reloads, timers 1 and 2 restart with it
+  double period = (TMR4_COMP10 + 1) * 1e9 / F_BUS_ACTUAL;
+  double t0h = TMR4_COMP11 * 1e9 / F_BUS_ACTUAL;
+  double t1h = TMR4_COMP12 * 1e9 / F_BUS_ACTUAL;
+  for (double t = 0; timer[2]->enabled && !failed; t += period) {
+    now = t;
+    request(timer[0]);
+    now = t + t0h;
+    request(timer[1]);
+    now = t + t1h;
+    request(timer[2]);
+  }
+  TMR4_ENBL &= ~7;
+
+  // every channel must have stopped with the last bit
+  for (uint8_t i = 0; i < 3; i++) {
+    if (timer[i] && timer[i]->enabled)
+      failed = true;
+  }
+  return !failed;
+}
@@ -0,0 +1,286 @@
+// Teensy OctoWS28 Artnet Node - OctoWS2811 waveform check
+// =================
+// Version: V0.2.1
+//
+// Runs the real OctoWS2811.cpp on the host, with its DMA transfers and
+// refill interrupts simulated (host/), and decodes every pin with the
+// WS2811Waveform golden model. Each frame must reach each pin as the bytes of
+// its strip followed by 0 bits up to the longest strip, with SK6812 timing,
+// in both output modes (chunks refilled by isr(), full frame bit buffer).
+// Covers ragged strips, several instances sharing the DMA, and strip sizes
+// around the chunk boundaries. Change fillplanes(), fillgroup() or isr(),
+// then from the node directory:
+//
+//   g++ -std=gnu++17 -O2 -D__IMXRT1062__ -DTEENSYDUINO=159
+//       -I test/waveform/host -I ../../OctoWS2811 -I native
+//       test/waveform/main.cpp test/waveform/host/imxrt_sim.cpp
+//       ../../OctoWS2811/OctoWS2811.cpp native/Arduino.cpp -o /tmp/waveform
+//   /tmp/waveform
+//
+// Exits with status 1 on the first stage with an error.
+
+#include <OctoWS2811.h>
+
+#include "WS2811Waveform.h"
+
+struct Output {
+  OctoWS2811 *leds;
+  uint8_t numPins;
+  const uint8_t *pins;
+  uint16_t lengths[NUM_DIGITAL_PINS];
+  uint8_t bytesPerLED;
+  uint8_t *draw;
+  std::vector<uint8_t> sent; // last frame shown
+};
+
+// Pins of the synthetic map in host/imxrt.h
+const uint8_t pinsA[36] = {5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+                           17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
+                           29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40};
+const uint8_t pinsB[13] = {41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53};
+const uint8_t pinsC[6] = {0, 1, 2, 3, 4, 54};
+
+const uint16_t lengthsB[13] = {150, 1, 27, 0, 13, 26, 27, 40, 80, 99, 100, 149, 7};
+
+uint8_t frameA[36 * 138 * 4], drawA[sizeof(frameA)];
+uint8_t frameB[13 * 150 * 3], drawB[sizeof(frameB)];
+uint8_t frameC[6 * 300 * 4], drawC[sizeof(frameC)];
+uint32_t bitBuffer[OCTOWS2811_BITBUFFER_SIZE(300, 3) / 4];
+
+Output outA = {new OctoWS2811(138, frameA, drawA, WS2811_GRBW, 36, pinsA), 36, pinsA};
+Output outB = {new OctoWS2811(150, frameB, drawB, WS2811_RGB, 13, pinsB), 13, pinsB};
+Output outC = {new OctoWS2811(1, frameC, drawC, WS2811_GRB, 6, pinsC), 6, pinsC};
+std::vector<Output *> live;
+
+struct Stats {
+  uint32_t frames = 0, errors = 0;
+  float high[2][2] = {{1e9f, 0}, {1e9f, 0}};
+  float period[2] = {1e9f, 0};
+  double frameNs = 0;
+};
+
+WS2811Waveform *current;
+double lastNs;
+uint32_t unexpected;
+
+void onGpio(uint8_t port, uint32_t reg, uint32_t value, double ns) {
+  if (reg == 0x84) {
+    current->set(port, value, ns);
+  } else if (reg == 0x88) {
+    current->clear(port, value, ns);
+  } else {
+    unexpected++;
+  }
+  lastNs = ns;
+}
+
+uint32_t random32() {
+  static uint32_t x = 2463534242u;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return x;
+}
+
+void begin(Output &o, uint16_t ledsPerStrip, uint8_t config, uint8_t *frame,
+           uint8_t *draw, const uint16_t *lengths) {
+  o.bytesPerLED = (config & 0x1F) < 6 ? 3 : 4;
+  o.draw = draw;
+  o.leds->begin(ledsPerStrip, frame, draw, config, o.numPins, o.pins);
+  for (uint8_t i = 0; i < o.numPins; i++)
+    o.lengths[i] = lengths ? lengths[i] : ledsPerStrip;
+  o.leds->setStripLengths(o.lengths);
+  o.leds->begin();
+  o.sent.assign(o.leds->numPixels() * o.bytesPerLED, 0);
+  for (Output *p : live) {
+    if (p == &o)
+      return;
+  }
+  live.push_back(&o);
+}
+
+uint32_t numBytes() {
+  uint32_t n = 0;
+  for (Output *o : live) {
+    for (uint8_t i = 0; i < o->numPins; i++) {
+      if (o->lengths[i] * o->bytesPerLED > n)
+        n = o->lengths[i] * o->bytesPerLED;
+    }
+  }
+  return n;
+}
+
+// Every pin of every instance against the frames last shown
+uint32_t verify(WS2811Waveform &wf, Stats &stats, const char *what) {
+  uint32_t numbytes = numBytes();
+  uint32_t errors = unexpected;
+  for (uint8_t port = 0; port < 4; port++)
+    errors += wf.stray[port];
+  for (Output *o : live) {
+    uint32_t start = 0;
+    for (uint8_t i = 0; i < o->numPins; i++) {
+      uint32_t len = o->lengths[i] * o->bytesPerLED;
+      std::vector<uint8_t> expect(numbytes, 0);
+      std::copy(o->sent.begin() + start, o->sent.begin() + start + len,
+                expect.begin());
+      start += len;
+
+      uint8_t pin = o->pins[i];
+      WS2811Pin &p = wf.pin(pin % 4, digitalPinToBit(pin));
+      bool same = p.frames.size() == 1 && p.frames[0] == expect;
+      if (!same || p.badHigh || p.badPeriod || p.partialBytes) {
+        if (errors < 8) {
+          Serial.printf("  %s: pin %u, %zu frames, %zu of %u bytes%s, %u bad "
+                        "high times, %u bad periods\n",
+                        what, pin, p.frames.size(),
+                        p.frames.empty() ? 0 : p.frames[0].size(), numbytes,
+                        same ? "" : " (differ)", p.badHigh, p.badPeriod);
+        }
+        errors++;
+      }
+      for (uint8_t b = 0; b < 2; b++) {
+        if (!p.count[b])
+          continue;
+        stats.high[b][0] = min(stats.high[b][0], p.highMin[b]);
+        stats.high[b][1] = max(stats.high[b][1], p.highMax[b]);
+      }
+      if (p.periodMax > 0) {
+        stats.period[0] = min(stats.period[0], p.periodMin);
+        stats.period[1] = max(stats.period[1], p.periodMax);
+      }
+    }
+  }
+  if (errors && unexpected)
+    Serial.printf("  %s: %u writes to other GPIO registers\n", what, unexpected);
+  return errors;
+}
+
+// Draw a random frame on o, show it and decode all the pins
+void check(Output &o, Stats &stats) {
+  for (uint8_t &b : o.sent)
+    b = random32();
+  memcpy(o.draw, o.sent.data(), o.sent.size());
+  o.leds->show();
+
+  WS2811Waveform wf(SK6812_TIMING);
+  for (Output *p : live) {
+    for (uint8_t i = 0; i < p->numPins; i++)
+      wf.watch(p->pins[i] % 4, 1u << digitalPinToBit(p->pins[i]));
+  }
+  current = &wf;
+  unexpected = 0;
+  lastNs = 0;
+  if (!host_run_qtimer4(onGpio)) {
+    Serial.println("  DMA: transfer out of GPIO1-4, or a channel not stopped");
+    stats.errors++;
+  }
+  wf.end();
+  stats.errors += verify(wf, stats, "DMA");
+  if (lastNs > stats.frameNs)
+    stats.frameNs = lastNs;
+  stats.frames++;
+}
+
+// Same frame check on the bit buffer: no DMA, the planes as fillplanes()
+// left them
+void checkPlanes(Stats &stats) {
+  WS2811Waveform wf(SK6812_TIMING);
+  uint32_t bitmask[4] = {0, 0, 0, 0};
+  for (Output *p : live) {
+    for (uint8_t i = 0; i < p->numPins; i++) {
+      wf.watch(p->pins[i] % 4, 1u << digitalPinToBit(p->pins[i]));
+      bitmask[p->pins[i] % 4] |= 1u << digitalPinToBit(p->pins[i]);
+    }
+  }
+  double ns = 0;
+  wf.octoPlanes(bitmask, bitBuffer, numBytes() * 8, ns,
+                (TMR4_COMP10 + 1) * 1e9 / F_BUS_ACTUAL,
+                TMR4_COMP11 * 1e9 / F_BUS_ACTUAL,
+                TMR4_COMP12 * 1e9 / F_BUS_ACTUAL);
+  wf.end();
+  unexpected = 0;
+  stats.errors += verify(wf, stats, "bit buffer");
+}
+
+// Show a frame from each of the given outputs, in both modes
+void stage(const char *name, std::initializer_list<Output *> outputs,
+           Stats *total = nullptr) {
+  Stats stats;
+  for (int mode = 0; mode < 2; mode++) {
+    if (mode && !outA.leds->setBitBuffer(bitBuffer)) {
+      Serial.printf("%s: setBitBuffer failed\n", name);
+      stats.errors++;
+      continue;
+    }
+    for (Output *o : outputs) {
+      check(*o, stats);
+      if (mode)
+        checkPlanes(stats);
+    }
+    outA.leds->setBitBuffer(nullptr);
+  }
+
+  if (total) {
+    total->frames += stats.frames;
+    total->errors += stats.errors;
+    for (uint8_t b = 0; b < 2; b++) {
+      total->high[b][0] = min(total->high[b][0], stats.high[b][0]);
+      total->high[b][1] = max(total->high[b][1], stats.high[b][1]);
+      total->period[b] = b ? max(total->period[b], stats.period[b])
+                           : min(total->period[b], stats.period[b]);
+    }
+    total->frameNs = max(total->frameNs, stats.frameNs);
+    if (!stats.errors)
+      return;
+  }
+  uint32_t pins = 0;
+  for (Output *o : live)
+    pins += o->numPins;
+  Serial.printf("%-34s %2u pins %4u bytes %3u frames %s  T0H %3.0f-%3.0f "
+                "T1H %3.0f-%3.0f bit %4.0f-%4.0f ns  %6.1f us\n",
+                name, pins, numBytes(), stats.frames,
+                stats.errors ? "ERROR" : "ok", stats.high[0][0],
+                stats.high[0][1], stats.high[1][0], stats.high[1][1],
+                stats.period[0], stats.period[1], stats.frameNs / 1000);
+  if (stats.errors)
+    exit(1);
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  // Chunk boundaries: strips of 3 to 180 bytes, the shorter pins ragged
+  for (uint8_t config : {WS2811_GRB, WS2811_GRBW}) {
+    Stats total;
+    for (uint16_t leds = 1; leds <= 45; leds++) {
+      uint16_t lengths[6];
+      for (uint8_t i = 0; i < 6; i++)
+        lengths[i] = leds * (6 - i) / 6;
+      begin(outC, leds, config, frameC, drawC, lengths);
+      stage(config == WS2811_GRB ? "RGB 1-45 LEDs" : "GRBW 1-45 LEDs", {&outC},
+            &total);
+    }
+    Serial.printf("%-34s %2u pins  3-180 bytes %3u frames %s  T0H %3.0f-%3.0f "
+                  "T1H %3.0f-%3.0f bit %4.0f-%4.0f ns\n",
+                  config == WS2811_GRB ? "sweep, ragged RGB" : "sweep, ragged GRBW",
+                  outC.numPins, total.frames, total.errors ? "ERROR" : "ok",
+                  total.high[0][0], total.high[0][1], total.high[1][0],
+                  total.high[1][1], total.period[0], total.period[1]);
+  }
+
+  // The first instance is kept with empty strips, its pins get only 0 bits
+  const uint16_t none[6] = {0, 0, 0, 0, 0, 0};
+  begin(outC, 1, WS2811_GRB, frameC, drawC, none);
+  begin(outA, 138, WS2811_GRBW, frameA, drawA, nullptr);
+  stage("Etendard V2.a, 36 x 138 GRBW", {&outA});
+
+  begin(outB, 150, WS2811_RGB, frameB, drawB, lengthsB);
+  stage("+ 13 ragged RGB, 0 to 150 LEDs", {&outB, &outA});
+
+  begin(outC, 300, WS2811_GRB, frameC, drawC, nullptr);
+  stage("+ 6 x 300 GRB", {&outC, &outA, &outB});
+
+  exit(0);
+}
+
+void loop() {}
@@ -24,7 +24,7 @@ THE SOFTWARE.
 
 #include <Artnet.h>
 
-Artnet::Artnet() {}
+Artnet::Artnet() : packetBuffer(artnetPacket) {}
 
 void Artnet::begin(byte mac[], byte ip[])
 {
@@ -52,25 +52,25 @@ uint16_t Artnet::read()
   remoteIP = Udp.remoteIP();
   if (packetSize <= MAX_BUFFER_ARTNET && packetSize > 0)
   {
-    Udp.read(artnetPacket, MAX_BUFFER_ARTNET);
+    Udp.read(packetBuffer, MAX_BUFFER_ARTNET);
 
     // Check that packetID is "Art-Net" else ignore
     for (byte i = 0; i < 8; i++)
     {
-      if (artnetPacket[i] != ART_NET_ID[i])
+      if (packetBuffer[i] != ART_NET_ID[i])
         return 0;
     }
 
-    opcode = artnetPacket[8] | artnetPacket[9] << 8;
+    opcode = packetBuffer[8] | packetBuffer[9] << 8;
 
     if (opcode == ART_DMX)
     {
-      sequence = artnetPacket[12];
-      incomingUniverse = artnetPacket[14] | artnetPacket[15] << 8;
-      dmxDataLength = artnetPacket[17] | artnetPacket[16] << 8;
+      sequence = packetBuffer[12];
+      incomingUniverse = packetBuffer[14] | packetBuffer[15] << 8;
+      dmxDataLength = packetBuffer[17] | packetBuffer[16] << 8;
 
       if (artDmxCallback)
-        (*artDmxCallback)(incomingUniverse, dmxDataLength, sequence, artnetPacket + ART_DMX_START, remoteIP);
+        (*artDmxCallback)(incomingUniverse, dmxDataLength, sequence, packetBuffer + ART_DMX_START, remoteIP);
       return ART_DMX;
     }
     if (opcode == ART_POLL)
@@ -161,6 +161,29 @@ uint16_t Artnet::read()
   return 0;
 }
 
+artnet_read_stats_s Artnet::readAll(uint16_t maxPackets, uint32_t budgetMicros)
+{
+  artnet_read_stats_s stats = {0, 0, 0};
+  uint32_t start = micros();
+
+  while (stats.packets + stats.rejects < maxPackets)
+  {
+    uint16_t result = read();
+    if (packetSize == 0)
+      break; // socket drained
+
+    stats.bytes += packetSize;
+    if (result == 0 && (packetSize > MAX_BUFFER_ARTNET || memcmp(packetBuffer, ART_NET_ID, 8) != 0))
+      stats.rejects++;
+    else
+      stats.packets++;
+
+    if (micros() - start >= budgetMicros)
+      break;
+  }
+  return stats;
+}
+
 void Artnet::printPacketHeader()
 {
   Serial.print("packet size = ");
@@ -179,7 +202,7 @@ void Artnet::printPacketContent()
 {
   for (uint16_t i = ART_DMX_START; i < dmxDataLength; i++)
   {
-    Serial.print(artnetPacket[i], DEC);
+    Serial.print(packetBuffer[i], DEC);
     Serial.print("  ");
   }
   Serial.println('\n');
@@ -97,6 +97,14 @@ struct artnet_reply_s
   uint8_t filler[26];
 } __attribute__((packed));
 
+// Counters returned by Artnet::readAll()
+struct artnet_read_stats_s
+{
+  uint16_t packets; // Art-Net packets handled
+  uint32_t bytes;   // UDP payload bytes pulled from the socket
+  uint16_t rejects; // oversized or non Art-Net packets
+};
+
 class Artnet
 {
 public:
@@ -106,13 +114,22 @@ public:
   void begin();
   void setBroadcast(byte bc[]);
   uint16_t read();
+  // Read every pending packet, up to maxPackets or until budgetMicros elapsed
+  artnet_read_stats_s readAll(uint16_t maxPackets, uint32_t budgetMicros);
   void printPacketHeader();
   void printPacketContent();
 
   // Return a pointer to the start of the DMX data
   inline uint8_t *getDmxFrame(void)
   {
-    return artnetPacket + ART_DMX_START;
+    return packetBuffer + ART_DMX_START;
+  }
+
+  // Receive the next packets into buffer (at least MAX_BUFFER_ARTNET bytes)
+  // instead of the internal one, nullptr to go back to the internal buffer
+  inline void setPacketBuffer(uint8_t *buffer)
+  {
+    packetBuffer = buffer ? buffer : artnetPacket;
   }
 
   inline uint16_t getOpcode(void)
@@ -161,6 +178,7 @@ private:
   struct artnet_reply_s ArtPollReply;
 
   uint8_t artnetPacket[MAX_BUFFER_ARTNET];
+  uint8_t *packetBuffer;
   uint16_t packetSize;
   IPAddress broadcast;
   uint16_t opcode;
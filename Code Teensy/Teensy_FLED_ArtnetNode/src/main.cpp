@@ -76,6 +76,10 @@ unsigned long previousMillis = 0;
 // i.e. 510 leds / 3 universes per pin
 #define FRAMES_PER_SECOND 30
 
+// Read every pending Artnet packet on each loop, within these limits
+#define ARTNET_MAX_PACKETS_PER_LOOP 64
+#define ARTNET_READ_BUDGET_US 1000
+
 // CHANGE FOR YOUR SETUP most software this is 1, some software send out artnet
 // first universe as 0.
 const int startUniverse = 0;
@@ -335,7 +339,7 @@ void setup() {
 void loop() {
   // we call the read function inside the loop
   if (artnet_set == 1) {
-    artnet.read();
+    artnet.readAll(ARTNET_MAX_PACKETS_PER_LOOP, ARTNET_READ_BUDGET_US);
   } else {
     delay(1000);
     initTest();
@@ -46,30 +46,45 @@ TRESET = 80us
 #define BYTES_PER_DMA	40
 
 uint8_t OctoWS2811::defaultPinList[8] = {2, 14, 7, 8, 6, 20, 21, 5};
-uint16_t OctoWS2811::stripLen;
-//uint8_t OctoWS2811::brightness = 255;
-void * OctoWS2811::frameBuffer;
-void * OctoWS2811::drawBuffer;
-uint8_t OctoWS2811::params;
 DMAChannel OctoWS2811::dma1;
 DMAChannel OctoWS2811::dma2;
 DMAChannel OctoWS2811::dma3;
 static DMASetting dma2next;
-static uint32_t numbytes;
 
-static uint8_t numpins;
-static uint8_t pinlist[NUM_DIGITAL_PINS]; // = {2, 14, 7, 8, 6, 20, 21, 5};
-static uint8_t pin_bitnum[NUM_DIGITAL_PINS];
-static uint8_t pin_offset[NUM_DIGITAL_PINS];
+// All instances share QuadTimer4, the 3 XBAR DMA requests and the 3 DMA
+// channels: XBAR1 has only 4 DMA request outputs and each waveform needs 3.
+// Their pins are merged in the same bit planes and shift out in parallel.
+// The output lasts as long as the longest instance, shorter strips receive
+// extra 0 bits after their last LED, which they ignore.
+static OctoWS2811 *instance[OCTOWS2811_MAX_INSTANCES];
+static uint8_t num_instances = 0;
+static uint32_t numbytes = 0;		// bytes per strip of the longest instance
+static bool hardware_ready = false;
+
+// Pin groups of all instances, by GPIO port, in the order they are filled
+static octo_pin_group_t *fill_group[OCTOWS2811_MAX_INSTANCES * OCTOWS2811_MAX_PIN_GROUPS];
+static OctoWS2811 *fill_owner[OCTOWS2811_MAX_INSTANCES * OCTOWS2811_MAX_PIN_GROUPS];
+static uint8_t num_fill = 0;
 
 static uint16_t comp1load[3];
 DMAMEM static uint32_t bitmask[4] __attribute__ ((used, aligned(32)));
 DMAMEM static uint32_t bitdata[BYTES_PER_DMA*64] __attribute__ ((used, aligned(32)));
 volatile uint32_t framebuffer_index = 0;
+static uint32_t *bitbuffer = NULL;	// whole frame of bit planes, or NULL
 volatile bool dma_first;
 
 static uint32_t update_begin_micros = 0;
 
+// Frames are numbered when they start, the DMA interrupt records the last
+// one sent.  A fence is the number of a frame, 0 is never used.
+static volatile uint32_t fence_started = 0;
+static volatile uint32_t fence_done = 0;
+static void (*complete_callback)(void) = NULL;
+
+volatile uint32_t OctoWS2811::fillCycles = 0;
+volatile uint32_t OctoWS2811::fillCyclesMax = 0;
+uint32_t OctoWS2811::copyBytes = 0;
+
 OctoWS2811::OctoWS2811(uint32_t numPerStrip, void *frameBuf, void *drawBuf, uint8_t config, uint8_t numPins, const uint8_t *pinList)
 {
 	stripLen = numPerStrip;
@@ -79,6 +94,13 @@ OctoWS2811::OctoWS2811(uint32_t numPerStrip, void *frameBuf, void *drawBuf, uint
 	if (numPins > NUM_DIGITAL_PINS) numPins = NUM_DIGITAL_PINS;
 	numpins = numPins;
 	memcpy(pinlist, pinList, numpins);
+	for (uint32_t i=0; i < numpins; i++) pin_len[i] = numPerStrip;
+	bytesPerStrip = 0;
+	bufsize = 0;
+	num_groups = 0;
+	rotate = false;
+	queueBuffer = NULL;
+	queued = false;
 }
 
 
@@ -91,43 +113,190 @@ void OctoWS2811::begin(uint32_t numPerStrip, void *frameBuf, void *drawBuf, uint
 	if (numPins > NUM_DIGITAL_PINS) numPins = NUM_DIGITAL_PINS;
 	numpins = numPins;
 	memcpy(pinlist, pinList, numpins);
+	for (uint32_t i=0; i < numpins; i++) pin_len[i] = numPerStrip;
 	begin();
 }
 
 int OctoWS2811::numPixels(void)
 {
-	return stripLen * numpins;
+	uint32_t count = 0;
+	for (uint32_t i=0; i < numpins; i++) count += pin_len[i];
+	return count;
+}
+
+void OctoWS2811::setStripLengths(const uint16_t *lengths)
+{
+	stripLen = 0;
+	for (uint32_t i=0; i < numpins; i++) {
+		pin_len[i] = lengths[i];
+		if (lengths[i] > stripLen) stripLen = lengths[i];
+	}
+}
+
+bool OctoWS2811::setBitBuffer(void *buf)
+{
+	if (buf == NULL) {
+		while (!dma3.complete()) ; // wait for any prior DMA operation
+		bitbuffer = NULL;
+		dma2.TCD->BITER_ELINKNO = BYTES_PER_DMA * 8;
+		return true;
+	}
+	// a single DMA major loop transfers at most 32767 bit planes
+	if (numbytes == 0 || numbytes * 8 > 32767) return false;
+	while (!dma3.complete()) ; // wait for any prior DMA operation
+	memset(buf, 0, numbytes * 128);
+	arm_dcache_flush_delete(buf, numbytes * 128);
+	bitbuffer = (uint32_t *)buf;
+	return true;
+}
+
+void OctoWS2811::setBuffers(bool swap, void *thirdBuf)
+{
+	while (!dma3.complete()) ; // wait for any prior DMA operation
+	if (drawBuffer == frameBuffer) swap = false; // nothing to rotate
+	rotate = swap;
+	queueBuffer = swap ? thirdBuf : NULL;
+	queued = false;
+	if (queueBuffer) memset(queueBuffer, 0, bufsize);
+}
+
+void OctoWS2811::present(void)
+{
+	if (!queueBuffer) return;
+	// a queued frame not sent yet is replaced by the newer one
+	void *buf = drawBuffer;
+	drawBuffer = queueBuffer;
+	queueBuffer = buf;
+	queued = true;
+}
+
+bool OctoWS2811::pending(void)
+{
+	return queued;
 }
 
 extern "C" void xbar_connect(unsigned int input, unsigned int output); // in pwm.c
 static volatile uint32_t *standard_gpio_addr(volatile uint32_t *fastgpio) {
-	return (volatile uint32_t *)((uint32_t)fastgpio - 0x01E48000);
+	return (volatile uint32_t *)((uintptr_t)fastgpio - 0x01E48000);
 }
 
 void OctoWS2811::begin(void)
 {
+	uint32_t bytesPerLED;
 	if ((params & 0x1F) < 6) {
-		numbytes = stripLen * 3; // RGB formats
+		bytesPerLED = 3; // RGB formats
 	} else {
-		numbytes = stripLen * 4; // RGBW formats
+		bytesPerLED = 4; // RGBW formats
+	}
+	bytesPerStrip = stripLen * bytesPerLED;
+	bufsize = numPixels() * bytesPerLED;
+
+	// wait for any prior DMA operation before changing the shared setup
+	if (hardware_ready) {
+		while (!dma3.complete()) ;
+	}
+
+	// register this instance
+	uint32_t n;
+	for (n=0; n < num_instances; n++) {
+		if (instance[n] == this) break;
+	}
+	if (n == num_instances) {
+		if (num_instances >= OCTOWS2811_MAX_INSTANCES) return;
+		instance[num_instances++] = this;
 	}
 
 	// configure which pins to use
-	memset(bitmask, 0, sizeof(bitmask));
 	for (uint32_t i=0; i < numpins; i++) {
 		uint8_t pin = pinlist[i];
+		pin_offset[i] = 0xFF;
 		if (pin >= NUM_DIGITAL_PINS) continue; // ignore illegal pins
 		uint8_t bit = digitalPinToBit(pin);
-		uint8_t offset = ((uint32_t)portOutputRegister(pin) - (uint32_t)&GPIO6_DR) >> 14;
+		uint8_t offset = ((uintptr_t)portOutputRegister(pin) - (uintptr_t)&GPIO6_DR) >> 14;
 		if (offset > 3) continue; // ignore unknown pins
 		pin_bitnum[i] = bit;
 		pin_offset[i] = offset;
 		uint32_t mask = 1 << bit;
-		bitmask[offset] |= mask;
 		*(&IOMUXC_GPR_GPR26 + offset) &= ~mask;
 		*standard_gpio_addr(portModeRegister(pin)) |= mask;
 	}
+
+	// group the pins by GPIO port for the bit transpose
+	memset(pin_group, 0, sizeof(pin_group));
+	num_groups = 0;
+	for (uint32_t offset=0; offset < 4; offset++) {
+		octo_pin_group_t *g = NULL;
+		uint32_t start = 0;
+		for (uint32_t i=0; i < numpins; start += pin_len[i++] * bytesPerLED) {
+			if (pin_offset[i] != offset) continue; // other port or ignored
+			if (g == NULL || g->count == 8) {
+				if (num_groups >= OCTOWS2811_MAX_PIN_GROUPS) break;
+				g = &pin_group[num_groups++];
+				g->offset = offset;
+			}
+			// lane k of a group lands in bit 7-k of each plane
+			uint32_t lane = 7 - g->count;
+			uint32_t mask = 1 << pin_bitnum[i];
+			for (uint32_t v=0; v < 16; v++) {
+				if (lane < 4 && (v & (1 << lane))) g->lo[v] |= mask;
+				if (lane >= 4 && (v & (1 << (lane - 4)))) g->hi[v] |= mask;
+			}
+			g->start[g->count] = start;
+			g->len[g->count] = pin_len[i] * bytesPerLED;
+			g->mask[g->count] = mask;
+			g->count++;
+		}
+	}
+
+	// merge the pins of all instances: the first group of each port stores
+	// its words, the others OR them
+	memset(bitmask, 0, sizeof(bitmask));
+	numbytes = 0;
+	num_fill = 0;
+	for (uint32_t offset=0; offset < 4; offset++) {
+		bool first = true;
+		for (uint32_t n=0; n < num_instances; n++) {
+			OctoWS2811 *p = instance[n];
+			for (uint32_t i=0; i < p->num_groups; i++) {
+				octo_pin_group_t *g = &p->pin_group[i];
+				if (g->offset != offset) continue;
+				g->first = first;
+				first = false;
+				bitmask[offset] |= g->lo[15] | g->hi[15];
+				fill_group[num_fill] = g;
+				fill_owner[num_fill] = p;
+				num_fill++;
+			}
+		}
+	}
+	for (uint32_t n=0; n < num_instances; n++) {
+		if (instance[n]->bytesPerStrip > numbytes) numbytes = instance[n]->bytesPerStrip;
+	}
 	arm_dcache_flush_delete(bitmask, sizeof(bitmask));
+	if (bitbuffer) {
+		// ports without pins are never written by fillplanes()
+		memset(bitbuffer, 0, numbytes * 128);
+		arm_dcache_flush_delete(bitbuffer, numbytes * 128);
+	}
+
+	// set up the buffers
+	memset(frameBuffer, 0, bufsize);
+	if (drawBuffer) {
+		memset(drawBuffer, 0, bufsize);
+	} else {
+		drawBuffer = frameBuffer;
+	}
+
+	if (hardware_ready) {
+		// the timers and DMA are running for another instance, only the
+		// length of the output may have changed
+		dma1.TCD->CITER_ELINKNO = numbytes * 8;
+		dma1.TCD->BITER_ELINKNO = numbytes * 8;
+		dma3.TCD->CITER_ELINKNO = numbytes * 8;
+		dma3.TCD->BITER_ELINKNO = numbytes * 8;
+		return;
+	}
+	hardware_ready = true;
 
 	// Set up 3 timers to create waveform timing events
 	comp1load[0] = (uint16_t)((float)F_BUS_ACTUAL * (float)TH_TL);
@@ -195,7 +364,7 @@ void OctoWS2811::begin(void)
 	dma2next.TCD->DADDR = &GPIO1_DR_CLEAR;
 	dma2next.TCD->DOFF = 16384;
 	dma2next.TCD->CITER_ELINKNO = BYTES_PER_DMA * 8;
-	dma2next.TCD->DLASTSGA = (int32_t)(dma2next.TCD);
+	dma2next.TCD->DLASTSGA = (int32_t)(uintptr_t)(dma2next.TCD);
 	dma2next.TCD->BITER_ELINKNO = BYTES_PER_DMA * 8;
 	dma2next.TCD->CSR = 0;
 
@@ -217,40 +386,109 @@ void OctoWS2811::begin(void)
 	dma3.TCD->CITER_ELINKNO = numbytes * 8;
 	dma3.TCD->DLASTSGA = -65536;
 	dma3.TCD->BITER_ELINKNO = numbytes * 8;
-	dma3.TCD->CSR = DMA_TCD_CSR_DREQ | DMA_TCD_CSR_DONE;
+	dma3.TCD->CSR = DMA_TCD_CSR_DREQ | DMA_TCD_CSR_DONE | DMA_TCD_CSR_INTMAJOR;
 	dma3.triggerAtHardwareEvent(DMAMUX_SOURCE_XBAR1_2);
+	dma3.attachInterrupt(isr_complete);
+}
 
-	// set up the buffers
-	uint32_t bufsize = numbytes * numpins;
-	memset(frameBuffer, 0, bufsize);
-	if (drawBuffer) {
-		memset(drawBuffer, 0, bufsize);
-	} else {
-		drawBuffer = frameBuffer;
+// Past the end of its strip, a pin receives 0 bits, which it ignores
+template <bool first>
+static void fillpad(uint32_t *dest, uint32_t mask, uint32_t n)
+{
+	for (uint32_t i=0; i < n * 8; i++) {
+		if (first) {
+			dest[i*4] = mask;
+		} else {
+			dest[i*4] |= mask;
+		}
+	}
+}
+
+// Convert n bytes of every strip in a group, from byte index, to GPIO bit
+// planes.  dest receives 8 planes of 4 words (one per port) for each byte.
+// A bit is set where the data bit is 0, since DMA writes these planes to
+// GPIO_DR_CLEAR.
+template <bool first>
+static void fillgroup(uint32_t *dest, const octo_pin_group_t *g, const uint8_t *pixels,
+	uint32_t index, uint32_t n)
+{
+	const uint32_t *lo = g->lo;
+	const uint32_t *hi = g->hi;
+	dest += g->offset;
+
+	while (n > 0) {
+		// convert up to the end of the next strip to end.  Lanes past the
+		// end of their strip, or unused, read another strip: the pad mask
+		// then sets their bits in every plane.
+		const uint8_t *p[8];
+		const uint8_t *any = NULL;
+		uint32_t pad = 0;
+		uint32_t len = n;
+		for (uint32_t k=0; k < g->count; k++) {
+			if (index < g->len[k]) {
+				p[k] = pixels + g->start[k] + index;
+				any = p[k];
+				if (g->len[k] - index < len) len = g->len[k] - index;
+			} else {
+				p[k] = NULL;
+				pad |= g->mask[k];
+			}
+		}
+		if (any == NULL) {
+			fillpad<first>(dest, pad, n);
+			return;
+		}
+		for (uint32_t k=0; k < 8; k++) {
+			if (k >= g->count || p[k] == NULL) p[k] = any;
+		}
+
+		for (uint32_t i=0; i < len; i++) {
+			uint32_t x = (p[0][i] << 24) | (p[1][i] << 16) | (p[2][i] << 8) | p[3][i];
+			uint32_t y = (p[4][i] << 24) | (p[5][i] << 16) | (p[6][i] << 8) | p[7][i];
+			x = ~x;
+			y = ~y;
+			// 8x8 bit matrix transpose, Hacker's Delight 7-3
+			uint32_t t;
+			t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+			t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+			t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+			t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+			t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+			y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+			x = t;
+			// x holds planes 0-3 (MSB first), y planes 4-7
+			#define PLANE(b, v) \
+				if (first) dest[(b)*4] = lo[(v) & 15] | hi[((v) >> 4) & 15] | pad; \
+				else dest[(b)*4] |= lo[(v) & 15] | hi[((v) >> 4) & 15] | pad;
+			PLANE(0, x >> 24)
+			PLANE(1, x >> 16)
+			PLANE(2, x >> 8)
+			PLANE(3, x)
+			PLANE(4, y >> 24)
+			PLANE(5, y >> 16)
+			PLANE(6, y >> 8)
+			PLANE(7, y)
+			#undef PLANE
+			dest += 32;
+		}
+		index += len;
+		n -= len;
 	}
 }
 
-static void fillbits(uint32_t *dest, const uint8_t *pixels, int n, uint32_t mask)
+// Fill n bytes of bit planes, starting at byte index of every strip of every
+// instance.  Ports with no pins are never written, their words stay zero.
+void OctoWS2811::fillplanes(uint32_t *dest, uint32_t index, uint32_t n)
 {
-	do {
-		uint8_t pix = *pixels++; 
-		if (!(pix & 0x80)) *dest |= mask;
-		dest += 4;
-		if (!(pix & 0x40)) *dest |= mask;
-		dest += 4;
-		if (!(pix & 0x20)) *dest |= mask;
-		dest += 4;
-		if (!(pix & 0x10)) *dest |= mask;
-		dest += 4;
-		if (!(pix & 0x08)) *dest |= mask;
-		dest += 4;
-		if (!(pix & 0x04)) *dest |= mask;
-		dest += 4;
-		if (!(pix & 0x02)) *dest |= mask;
-		dest += 4;
-		if (!(pix & 0x01)) *dest |= mask;
-		dest += 4;
-	} while (--n > 0);
+	for (uint32_t i=0; i < num_fill; i++) {
+		const octo_pin_group_t *g = fill_group[i];
+		const uint8_t *pixels = (const uint8_t *)fill_owner[i]->frameBuffer;
+		if (g->first) {
+			fillgroup<true>(dest, g, pixels, index, n);
+		} else {
+			fillgroup<false>(dest, g, pixels, index, n);
+		}
+	}
 }
 
 void OctoWS2811::show(void)
@@ -258,10 +496,38 @@ void OctoWS2811::show(void)
 	// wait for any prior DMA operation
 	while (!dma3.complete()) ; // wait
 
-	// it's ok to copy the drawing buffer to the frame buffer
-	// during the 50us WS2811 reset time
-	if (drawBuffer != frameBuffer) {
-		memcpy(frameBuffer, drawBuffer, numbytes * numpins);
+	// the frame to send: the one queued by present(), or the drawing buffer
+	void *next = drawBuffer;
+	if (queued) {
+		next = queueBuffer;
+		queued = false;
+	}
+
+	if (rotate) {
+		// the frame to send becomes the frame buffer, the old frame buffer
+		// is reused for drawing (or as the spare third buffer)
+		void *buf = frameBuffer;
+		frameBuffer = next;
+		if (next == drawBuffer) {
+			drawBuffer = buf;
+		} else {
+			queueBuffer = buf;
+		}
+	} else if (next != frameBuffer) {
+		// it's ok to copy the drawing buffer to the frame buffer
+		// during the 50us WS2811 reset time
+		memcpy(frameBuffer, next, bufsize);
+		copyBytes += bufsize;
+	}
+
+	// with a bit buffer, the whole frame is converted now and DMA streams
+	// it with no interrupt
+	if (bitbuffer) {
+		uint32_t begin_cycles = ARM_DWT_CYCCNT;
+		fillplanes(bitbuffer, 0, numbytes);
+		fillCycles = ARM_DWT_CYCCNT - begin_cycles;
+		if (fillCycles > fillCyclesMax) fillCyclesMax = fillCycles;
+		arm_dcache_flush_delete(bitbuffer, numbytes * 128);
 	}
 
 	// disable timers
@@ -277,40 +543,45 @@ void OctoWS2811::show(void)
 	XBARA1_CTRL0 |= XBARA_CTRL_STS1 | XBARA_CTRL_STS0;
 	XBARA1_CTRL1 |= XBARA_CTRL_STS0;
 
-	// fill the DMA transmit buffer
-	//digitalWriteFast(12, HIGH);
-	memset(bitdata, 0, sizeof(bitdata));
-	uint32_t count = numbytes;
-	if (count > BYTES_PER_DMA*2) count = BYTES_PER_DMA*2;
-	framebuffer_index = count;
-	for (uint32_t i=0; i < numpins; i++) {
-		fillbits(bitdata + pin_offset[i], (uint8_t *)frameBuffer + i*numbytes,
-			count, 1<<pin_bitnum[i]);
-	}
-	arm_dcache_flush_delete(bitdata, count * 128);
-	//digitalWriteFast(12, LOW);
-
-        // set up DMA transfers
-        if (numbytes <= BYTES_PER_DMA*2) {
-		dma2.TCD->SADDR = bitdata;
+	if (bitbuffer) {
+		dma2.TCD->SADDR = bitbuffer;
 		dma2.TCD->DADDR = &GPIO1_DR_CLEAR;
-		dma2.TCD->CITER_ELINKNO = count * 8;
+		dma2.TCD->CITER_ELINKNO = numbytes * 8;
+		dma2.TCD->BITER_ELINKNO = numbytes * 8;
 		dma2.TCD->CSR = DMA_TCD_CSR_DREQ;
-        } else {
-		dma2.TCD->SADDR = bitdata;
-		dma2.TCD->DADDR = &GPIO1_DR_CLEAR;
-		dma2.TCD->CITER_ELINKNO = BYTES_PER_DMA * 8;
-		dma2.TCD->CSR = 0;
-		dma2.TCD->CSR = DMA_TCD_CSR_INTMAJOR | DMA_TCD_CSR_ESG;
-		dma2next.TCD->SADDR = bitdata + BYTES_PER_DMA*32;
-		dma2next.TCD->CITER_ELINKNO = BYTES_PER_DMA * 8;
-		if (numbytes <= BYTES_PER_DMA*3) {
-			dma2next.TCD->CSR = DMA_TCD_CSR_ESG;
+	} else {
+		// fill the DMA transmit buffer
+		//digitalWriteFast(12, HIGH);
+		memset(bitdata, 0, sizeof(bitdata));
+		uint32_t count = numbytes;
+		if (count > BYTES_PER_DMA*2) count = BYTES_PER_DMA*2;
+		framebuffer_index = count;
+		fillplanes(bitdata, 0, count);
+		arm_dcache_flush_delete(bitdata, count * 128);
+		//digitalWriteFast(12, LOW);
+
+		// set up DMA transfers
+		if (numbytes <= BYTES_PER_DMA*2) {
+			dma2.TCD->SADDR = bitdata;
+			dma2.TCD->DADDR = &GPIO1_DR_CLEAR;
+			dma2.TCD->CITER_ELINKNO = count * 8;
+			dma2.TCD->CSR = DMA_TCD_CSR_DREQ;
 		} else {
-			dma2next.TCD->CSR = DMA_TCD_CSR_ESG | DMA_TCD_CSR_INTMAJOR;
+			dma2.TCD->SADDR = bitdata;
+			dma2.TCD->DADDR = &GPIO1_DR_CLEAR;
+			dma2.TCD->CITER_ELINKNO = BYTES_PER_DMA * 8;
+			dma2.TCD->CSR = 0;
+			dma2.TCD->CSR = DMA_TCD_CSR_INTMAJOR | DMA_TCD_CSR_ESG;
+			dma2next.TCD->SADDR = bitdata + BYTES_PER_DMA*32;
+			dma2next.TCD->CITER_ELINKNO = BYTES_PER_DMA * 8;
+			if (numbytes <= BYTES_PER_DMA*3) {
+				dma2next.TCD->CSR = DMA_TCD_CSR_ESG;
+			} else {
+				dma2next.TCD->CSR = DMA_TCD_CSR_ESG | DMA_TCD_CSR_INTMAJOR;
+			}
+			dma_first = true;
 		}
-		dma_first = true;
-        }
+	}
 	dma3.clearComplete();
 	dma1.enable();
 	dma2.enable();
@@ -325,10 +596,38 @@ void OctoWS2811::show(void)
 	while (micros() - update_begin_micros < numbytes * 10 + 300) ;
 
 	// start everything running!
+	uint32_t fence = fence_started + 1;
+	if (fence == 0) fence = 1;
+	fence_started = fence;
 	TMR4_ENBL = enable | 7;
 	update_begin_micros = micros();
 }
 
+uint32_t OctoWS2811::showAsync(void)
+{
+	// the waits in show() only pass when busy() is false
+	if (busy()) return 0;
+	show();
+	return fence_started;
+}
+
+bool OctoWS2811::complete(uint32_t fence)
+{
+	return (int32_t)(fence_done - fence) >= 0;
+}
+
+void OctoWS2811::onComplete(void (*callback)(void))
+{
+	complete_callback = callback;
+}
+
+void OctoWS2811::isr_complete(void)
+{
+	dma3.clearInterrupt();
+	fence_done = fence_started;
+	if (complete_callback) complete_callback();
+}
+
 void OctoWS2811::isr(void)
 {
 	// first ack the interrupt
@@ -344,15 +643,15 @@ void OctoWS2811::isr(void)
 		dma_first = true;
 		dest = bitdata + BYTES_PER_DMA*32;
 	}
-	memset(dest, 0, sizeof(bitdata)/2);
 	uint32_t index = framebuffer_index;
 	uint32_t count = numbytes - framebuffer_index;
 	if (count > BYTES_PER_DMA) count = BYTES_PER_DMA;
 	framebuffer_index = index + count;
-	for (int i=0; i < numpins; i++) {
-		fillbits(dest + pin_offset[i], (uint8_t *)frameBuffer + index + i*numbytes,
-			count, 1<<pin_bitnum[i]);
-	}
+	uint32_t begin_cycles = ARM_DWT_CYCCNT;
+	fillplanes(dest, index, count);
+	uint32_t cycles = ARM_DWT_CYCCNT - begin_cycles;
+	fillCycles = cycles;
+	if (cycles > fillCyclesMax) fillCyclesMax = cycles;
 	arm_dcache_flush_delete(dest, count * 128);
 	//digitalWriteFast(12, LOW);
 
@@ -371,13 +670,13 @@ void OctoWS2811::isr(void)
 
 int OctoWS2811::busy(void)
 {
-	if (!dma3.complete()) ; // DMA still running
+	if (!dma3.complete()) return 1; // DMA still running
 	if (micros() - update_begin_micros < numbytes * 10 + 300) return 1; // WS2812 reset
 	return 0;
 }
 
 // For Teensy 4.x, the pixel data is stored in ordinary RGB format.  Translation
-// from 24 bit color to GPIO bitmasks is done on-the-fly by fillbits().  This is
+// from 24 bit color to GPIO bitmasks is done on-the-fly by fillplanes().  This is
 // different from Teensy 3.x, where the data was stored as bytes to write directly
 // to the GPIO output register.
 
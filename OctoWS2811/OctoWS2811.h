@@ -71,14 +71,52 @@
 #define WS2811_400kHz 0x40	// Adafruit's Flora Pixels
 #define WS2813_800kHz 0x80	// WS2813 are close to 800 kHz but has 300 us frame set delay
 
+// Size in bytes of a setBitBuffer() buffer: 8 bit planes of 4 GPIO ports
+// for every byte of a strip (Teensy 4.x only)
+#define OCTOWS2811_BITBUFFER_SIZE(numPerStrip, bytesPerLED) ((numPerStrip) * (bytesPerLED) * 128)
+
+#if defined(__IMXRT1062__)
+// Teensy 4.x: several objects may drive different pins at the same time, up
+// to this many.  They share the timer and DMA channels, see begin().
+#define OCTOWS2811_MAX_INSTANCES	4
+
+// Pins are handled in groups of up to 8 pins on the same GPIO port.  The 8
+// bytes of a group are transposed into 8 bit planes with word-wide operations,
+// then each plane is spread to the pins' GPIO bit positions with two 16 entry
+// tables.  This replaces testing every bit of every byte with a branch.
+#define OCTOWS2811_MAX_PIN_GROUPS	((NUM_DIGITAL_PINS + 7) / 8 + 4)
+typedef struct {
+	uint8_t offset;		// GPIO port, 0 to 3
+	uint8_t count;		// number of pins, 1 to 8
+	uint8_t first;		// first group on this port: store instead of OR
+	uint32_t start[8];	// byte offset of each strip in the buffers
+	uint32_t len[8];	// bytes in each strip
+	uint32_t mask[8];	// GPIO bit of each strip
+	uint32_t lo[16];	// GPIO mask for the 4 low bits of a plane
+	uint32_t hi[16];	// GPIO mask for the 4 high bits of a plane
+} octo_pin_group_t;
+#endif
+
 
 class OctoWS2811 {
 public:
 #if defined(__IMXRT1062__)
-	// Teensy 4.x can use any arbitrary group of pins!
+	// Teensy 4.x can use any arbitrary group of pins!  Several objects with
+	// different pins, lengths and buffers can be used at once: show() on any
+	// of them sends all of them in parallel.  All must use the same speed.
 	OctoWS2811(uint32_t numPerStrip, void *frameBuf, void *drawBuf, uint8_t config = WS2811_GRB, uint8_t numPins = 8, const uint8_t *pinList = defaultPinList);
 	void begin(uint32_t numPerStrip, void *frameBuf, void *drawBuf, uint8_t config = WS2811_GRB, uint8_t numPins = 8, const uint8_t *pinList = defaultPinList);
 	int numPixels(void);
+	// Optional buffer for the whole frame in GPIO bit plane form, see
+	// OCTOWS2811_BITBUFFER_SIZE.  show() converts the frame once and DMA
+	// streams it without interrupts.  Call after begin() of every object,
+	// size it for the longest strip.  NULL to stop.
+	bool setBitBuffer(void *buf);
+	// Optional length of each strip, in LEDs, in pinList order.  Call before
+	// begin().  The strips are stored one after the other in the buffers,
+	// which only need room for numPixels() pixels.  Output takes as long as
+	// the longest strip, the others receive nothing after their last LED.
+	void setStripLengths(const uint16_t *lengths);
 #else
 	// Teensy 3.x is fixed to 8 pins: 2, 14, 7, 8, 6, 20, 21, 5
 	OctoWS2811(uint32_t numPerStrip, void *frameBuf, void *drawBuf, uint8_t config = WS2811_GRB);
@@ -97,9 +135,35 @@ public:
 		setPixel(num, Color(red, green, blue, white));
 	}
 	int getPixel(uint32_t num);
+	// Direct access to the drawing buffer: numPixels() pixels of 3 (RGB) or
+	// 4 (RGBW) bytes each, already in the strip's color order
+	void *getDrawBuffer(void) {
+		return drawBuffer;
+	}
 
 	void show(void);
 	int busy(void);
+#if defined(__IMXRT1062__)
+	// Start sending the drawing buffer and return at once.  Returns 0 if the
+	// previous frame is still being sent (busy), otherwise a fence for
+	// complete().  The drawing buffer may be changed as soon as it returns.
+	uint32_t showAsync(void);
+	// True once the frame of this fence has been sent to the LEDs
+	bool complete(uint32_t fence);
+	// Function called from the DMA interrupt each time a frame has been
+	// sent.  The LEDs latch it after the reset time, busy() covers both.
+	void onComplete(void (*callback)(void));
+	// Rotate the buffers in show() instead of copying the drawing buffer to
+	// the frame buffer.  The drawing buffer then holds an older frame after
+	// show(), every pixel must be drawn again.  With thirdBuf (same size),
+	// present() queues a finished frame without waiting for the output.
+	void setBuffers(bool swap, void *thirdBuf = NULL);
+	// Queue the drawing buffer as the next frame and draw in another buffer
+	// at once.  The next show() or showAsync() sends the queued frame.
+	void present(void);
+	// True if a frame queued by present() is waiting to be sent
+	bool pending(void);
+#endif
 
 	int color(uint8_t red, uint8_t green, uint8_t blue) {
 		return (red << 16) | (green << 8) | blue;
@@ -127,8 +191,40 @@ public:
 	uint32_t Color(uint8_t red, uint8_t green, uint8_t blue, uint8_t white) {
 		return (white << 24) | (red << 16) | (green << 8) | blue;
 	}
+#if defined(__IMXRT1062__)
+	// CPU cycles the DMA interrupt spent converting the last chunk of pixels
+	// to GPIO bit planes (with setBitBuffer, show() converting the whole
+	// frame), and the largest seen (reset to 0 to measure again)
+	static volatile uint32_t fillCycles;
+	static volatile uint32_t fillCyclesMax;
+	// Bytes show() copied from the drawing buffer to the frame buffer since
+	// begin, 0 while setBuffers() rotates them (reset to 0 to measure again)
+	static uint32_t copyBytes;
+#endif
 
 private:
+#if defined(__IMXRT1062__)
+	uint16_t stripLen;
+	void *frameBuffer;
+	void *drawBuffer;
+	uint8_t params;
+	uint8_t numpins;
+	uint8_t pinlist[NUM_DIGITAL_PINS];
+	uint8_t pin_bitnum[NUM_DIGITAL_PINS];
+	uint8_t pin_offset[NUM_DIGITAL_PINS];
+	uint16_t pin_len[NUM_DIGITAL_PINS];	// LEDs on each pin
+	uint32_t bytesPerStrip;			// longest strip
+	uint32_t bufsize;			// bytes in each buffer
+	octo_pin_group_t pin_group[OCTOWS2811_MAX_PIN_GROUPS];
+	uint8_t num_groups;
+	bool rotate;			// swap buffers instead of copying
+	void *queueBuffer;		// third buffer: spare or queued frame
+	volatile bool queued;		// queueBuffer holds a frame to send
+	static DMAChannel dma1, dma2, dma3;
+	static void isr(void);
+	static void isr_complete(void);
+	static void fillplanes(uint32_t *dest, uint32_t index, uint32_t n);
+#else
 	static uint16_t stripLen;
 	//static uint8_t brightness;
 	static void *frameBuffer;
@@ -136,6 +232,7 @@ private:
 	static uint8_t params;
 	static DMAChannel dma1, dma2, dma3;
 	static void isr(void);
+#endif
 	static uint8_t defaultPinList[8];
 };
 
@@ -0,0 +1,96 @@
+/*  OctoWS2811 Teensy4_FillBenchmark.ino - Measure the bit plane conversion
+    http://www.pjrc.com/teensy/td_libs_OctoWS2811.html
+
+  On Teensy 4.x the pixel data is converted to GPIO bit planes 40 bytes per
+  strip at a time, inside the DMA interrupt.  This example prints the CPU
+  cycles spent per chunk by the library (grouped 8x8 bit transpose), next
+  to the original per-bit fillbits() run on the same pins and data.
+
+  Uses the 36 pins of the KXKM Etendard V2.a, 138 RGBW LEDs per strip.
+  Nothing needs to be connected.
+*/
+
+#include <OctoWS2811.h>
+
+const int numPins = 36;
+byte pinList[numPins] = {23, 22, 21, 20, 18, 17, 16, 15, 14, 13,
+                         41, 40, 39, 38, 37, 36, 35, 34, 33, 32,
+                         31, 30, 29, 28, 27, 26, 25, 24, 12, 11,
+                         10, 9,  8,  7,  6,  5};
+
+const int ledsPerStrip = 138;
+const int bytesPerLED = 4;
+const int bytesPerStrip = ledsPerStrip * bytesPerLED;
+const int chunk = 40;  // BYTES_PER_DMA in OctoWS2811.cpp
+
+DMAMEM int displayMemory[ledsPerStrip * numPins * bytesPerLED / 4];
+int drawingMemory[ledsPerStrip * numPins * bytesPerLED / 4];
+
+const int config = WS2811_GRBW | WS2811_800kHz;
+
+OctoWS2811 leds(ledsPerStrip, displayMemory, drawingMemory, config, numPins, pinList);
+
+// The conversion used before, one branch per bit
+static void fillbits(uint32_t *dest, const uint8_t *pixels, int n, uint32_t mask)
+{
+	do {
+		uint8_t pix = *pixels++;
+		if (!(pix & 0x80)) *dest |= mask;
+		dest += 4;
+		if (!(pix & 0x40)) *dest |= mask;
+		dest += 4;
+		if (!(pix & 0x20)) *dest |= mask;
+		dest += 4;
+		if (!(pix & 0x10)) *dest |= mask;
+		dest += 4;
+		if (!(pix & 0x08)) *dest |= mask;
+		dest += 4;
+		if (!(pix & 0x04)) *dest |= mask;
+		dest += 4;
+		if (!(pix & 0x02)) *dest |= mask;
+		dest += 4;
+		if (!(pix & 0x01)) *dest |= mask;
+		dest += 4;
+	} while (--n > 0);
+}
+
+uint32_t bitdata[chunk * 32];
+uint8_t pin_bitnum[numPins];
+uint8_t pin_offset[numPins];
+
+void setup() {
+	Serial.begin(115200);
+	while (!Serial && millis() < 3000) ;
+	for (int i=0; i < numPins; i++) {
+		pin_bitnum[i] = digitalPinToBit(pinList[i]);
+		pin_offset[i] = ((uint32_t)portOutputRegister(pinList[i]) - (uint32_t)&GPIO6_DR) >> 14;
+	}
+	leds.begin();
+	for (int i=0; i < leds.numPixels(); i++) {
+		leds.setPixel(i, random(256), random(256), random(256), random(256));
+	}
+}
+
+void loop() {
+	// before: original conversion of one chunk, including the buffer clear
+	uint32_t before = ARM_DWT_CYCCNT;
+	memset(bitdata, 0, sizeof(bitdata));
+	for (int i=0; i < numPins; i++) {
+		fillbits(bitdata + pin_offset[i], (uint8_t *)displayMemory + i * bytesPerStrip,
+			chunk, 1 << pin_bitnum[i]);
+	}
+	before = ARM_DWT_CYCCNT - before;
+
+	// after: the library records the cycles of every chunk converted in its
+	// DMA interrupt, the largest one is a full chunk
+	OctoWS2811::fillCyclesMax = 0;
+	leds.show();
+	while (leds.busy()) ;
+	uint32_t after = OctoWS2811::fillCyclesMax;
+
+	Serial.printf("%d pins, %d bytes per chunk: fillbits %lu cycles (%lu us), "
+		"transpose %lu cycles (%lu us)\n",
+		numPins, chunk, before, before / (F_CPU_ACTUAL / 1000000),
+		after, after / (F_CPU_ACTUAL / 1000000));
+	delay(1000);
+}
@@ -0,0 +1,51 @@
+/*  OctoWS2811 Teensy4_MultipleGroups.ino - Several groups of pins at once
+    http://www.pjrc.com/teensy/td_libs_OctoWS2811.html
+
+  With Teensy 4.x, several OctoWS2811 objects may be used together, each
+  with its own pins, strip length, color order and buffers.  They share the
+  same timer and DMA channels, so show() on any of them updates all of them
+  at the same time.  Here RGB strips of 120 LEDs and RGBW strips of 60 LEDs
+  are driven side by side.
+
+  Required Connections
+  --------------------
+    pin 2, 14, 7, 8:   RGB LED strips, 120 LEDs each
+    pin 6, 20, 21, 5:  RGBW LED strips, 60 LEDs each
+*/
+
+#include <OctoWS2811.h>
+
+const int numPinsA = 4;
+byte pinListA[numPinsA] = {2, 14, 7, 8};
+const int ledsPerStripA = 120;
+DMAMEM int displayMemoryA[ledsPerStripA * numPinsA * 3 / 4];
+int drawingMemoryA[ledsPerStripA * numPinsA * 3 / 4];
+
+const int numPinsB = 4;
+byte pinListB[numPinsB] = {6, 20, 21, 5};
+const int ledsPerStripB = 60;
+DMAMEM int displayMemoryB[ledsPerStripB * numPinsB * 4 / 4];
+int drawingMemoryB[ledsPerStripB * numPinsB * 4 / 4];
+
+// every group must use the same speed
+OctoWS2811 ledsA(ledsPerStripA, displayMemoryA, drawingMemoryA, WS2811_GRB | WS2811_800kHz, numPinsA, pinListA);
+OctoWS2811 ledsB(ledsPerStripB, displayMemoryB, drawingMemoryB, WS2811_GRBW | WS2811_800kHz, numPinsB, pinListB);
+
+void setup() {
+  ledsA.begin();
+  ledsB.begin();
+  ledsA.show();
+}
+
+void loop() {
+  static int hue = 0;
+  for (int i=0; i < ledsA.numPixels(); i++) {
+    ledsA.setPixel(i, ((i + hue) & 0xFF) << 16);
+  }
+  for (int i=0; i < ledsB.numPixels(); i++) {
+    ledsB.setPixel(i, 0, 0, 0, (i + hue) & 0xFF);
+  }
+  ledsA.show(); // sends both groups
+  hue++;
+  delay(10);
+}
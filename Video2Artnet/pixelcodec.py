@@ -0,0 +1,67 @@
+# Run-length / delta coding of ART_PIXEL packets, decoded by the node in
+# src/PixelDecoder.h (TeensyOctoWS28ArtnetNode).
+#
+# Packet data: pixel count (2 bytes, LSB first), then codes of n pixels,
+# n = (code & 0x3F) + 1:
+#   COPY | n-1  n RGB pixels follow
+#   RUN  | n-1  one RGB pixel follows, repeated n times
+#   SKIP | n-1  n pixels unchanged since the previous frame (delta frames)
+
+import struct
+
+COPY = 0x00
+RUN = 0x40
+SKIP = 0x80
+MAX_CODE_PIXELS = 64
+
+
+def encodeFrame(data, previous, max_length):
+    """Code a frame of RGB bytes against the previous one (None for a key
+    frame). Return the packets as (first pixel, pixel count, data), each
+    data at most max_length bytes."""
+    count = len(data) // 3
+    pixels = [bytes(data[i * 3:i * 3 + 3]) for i in range(count)]
+    last = [bytes(previous[i * 3:i * 3 + 3]) for i in range(count)] if previous is not None else None
+    budget = max_length - 2
+
+    def unchanged(i):
+        return last is not None and pixels[i] == last[i]
+
+    def repeated(i):
+        return i + 1 < count and pixels[i + 1] == pixels[i]
+
+    packets = []
+    codes = bytearray()
+    first = 0
+    i = 0
+    while i < count:
+        if unchanged(i):
+            n = 1
+            while i + n < count and n < MAX_CODE_PIXELS and unchanged(i + n):
+                n += 1
+            code = bytes([SKIP | (n - 1)])
+        elif repeated(i):
+            n = 2
+            while i + n < count and n < MAX_CODE_PIXELS and pixels[i + n] == pixels[i]:
+                n += 1
+            code = bytes([RUN | (n - 1)]) + pixels[i]
+        else:
+            n = 1
+            while i + n < count and n < MAX_CODE_PIXELS and not unchanged(i + n) and not repeated(i + n):
+                n += 1
+            # fill the packet up with the first pixels of the copy
+            room = (budget - len(codes) - 1) // 3
+            if room >= 1:
+                n = min(n, room)
+            code = bytes([COPY | (n - 1)]) + b"".join(pixels[i:i + n])
+
+        if len(codes) + len(code) > budget:
+            packets.append((first, i - first, struct.pack("<H", i - first) + codes))
+            codes = bytearray()
+            first = i
+            continue
+        codes += code
+        i += n
+
+    packets.append((first, count - first, struct.pack("<H", count - first) + codes))
+    return packets
@@ -1,7 +1,10 @@
 from stupidArtnet import StupidArtnet
 import numpy as np
 import cv2 as cv
+import socket
+import struct
 from time import sleep
+from pixelcodec import encodeFrame
 
 # MATRIX
 target_size = (36, 108)
@@ -9,7 +12,27 @@ target_ratio = target_size[0] / target_size[1]
 screen_offset = (0, 0)
 
 # ARTNET
-a = StupidArtnet("192.168.1.12")
+node_ip = "192.168.1.12"
+a = StupidArtnet(node_ip)
+
+# PIXEL PACKETS (ART_PIXEL, TeensyOctoWS28ArtnetNode only): the whole frame in
+# packets of up to 484 pixels instead of 510 byte universes
+pixel_packets = False
+ART_PIXEL = 0x5F00
+ART_PIXEL_LAST = 0x01
+ART_PIXEL_RLE = 0x02
+ART_PIXEL_DELTA = 0x04
+ART_PIXEL_MAX_PIXELS = 484
+ART_PIXEL_MAX_LENGTH = 1452
+pixel_socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+pixel_frame = 0
+pixel_sequence = 0
+
+# Compressed pixel packets (pixelcodec.py): a key frame every
+# keyframe_interval frames, only the changed pixels in between
+pixel_compression = False
+keyframe_interval = 25
+last_pixels = None
 
 # Make a red image matrix
 redImg = np.zeros((target_size[1], target_size[0], 3), np.uint8)
@@ -41,6 +64,32 @@ def waitVid():
         print(f"WARNING: Late by { int(late_by*1000) } ms")
 
 
+def sendPixels(data):
+    global pixel_frame, pixel_sequence, last_pixels
+    pixel_frame = (pixel_frame + 1) & 0xFFFF
+    data = data.tobytes()
+    count = len(data) // 3
+    if pixel_compression:
+        # delta against the previous frame, the node drops delta frames
+        # until it got a whole key frame
+        previous = last_pixels if pixel_frame % keyframe_interval else None
+        packets = encodeFrame(data, previous, ART_PIXEL_MAX_LENGTH)
+        coding = ART_PIXEL_RLE | (ART_PIXEL_DELTA if previous is not None else 0)
+        last_pixels = data
+    else:
+        packets = [(first, min(ART_PIXEL_MAX_PIXELS, count - first),
+                    data[first * 3:(first + ART_PIXEL_MAX_PIXELS) * 3])
+                   for first in range(0, count, ART_PIXEL_MAX_PIXELS)]
+        coding = 0
+    for first, pixels, payload in packets:
+        flags = coding | (ART_PIXEL_LAST if first + pixels == count else 0)
+        pixel_sequence = pixel_sequence % 255 + 1
+        # frame and first pixel LSB first, length MSB first (as in ArtDmx)
+        header = b"Art-Net\0" + struct.pack("<HBBHH", ART_PIXEL, pixel_sequence, flags, pixel_frame, first) \
+            + struct.pack(">H", len(payload))
+        pixel_socket.sendto(header + payload, (node_ip, 6454))
+
+
 def resizeFrame(frame):
     h, w, _ = frame.shape
     frame_ratio = w / h
@@ -113,19 +162,23 @@ while True:
         # reset all values to 0
         # artnet = np.zeros(artnet.shape, dtype=np.uint8)
 
-        # split artnet into 510 byte universe (!! 512 crop last pixel !!)
-        artnet = [artnet[i:i+510] for i in range(0, len(artnet), 510)]
-
-        # fill up each universe with 0
-        for i in range(len(artnet)):
-            artnet[i] = np.pad(artnet[i], (0, 512 - len(artnet[i])))
-
-        # send artnet
-        for i in range(len(artnet)):
-            # print(artnet[i])
-            a.set_universe(i)
-            a.set(artnet[i])
-            a.show()
+        if pixel_packets:
+            # send the frame in ART_PIXEL packets (9 instead of 23)
+            sendPixels(artnet)
+        else:
+            # split artnet into 510 byte universe (!! 512 crop last pixel !!)
+            artnet = [artnet[i:i+510] for i in range(0, len(artnet), 510)]
+
+            # fill up each universe with 0
+            for i in range(len(artnet)):
+                artnet[i] = np.pad(artnet[i], (0, 512 - len(artnet[i])))
+
+            # send artnet
+            for i in range(len(artnet)):
+                # print(artnet[i])
+                a.set_universe(i)
+                a.set(artnet[i])
+                a.show()
 
         # wait for next frame
         waitVid()